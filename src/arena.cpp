@@ -0,0 +1,156 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "arena.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::arena::arena(void)
+    : head_{nullptr}
+    , used_{0}
+    , reserved_{0}
+    , blocks_{0}
+{}
+dravex::arena::~arena(void)
+{
+    this->reset();
+}
+
+/**
+ * Ensures the current block can hold the given number of bytes without allocating another block.
+ *
+ * @param {std::size_t} size - The number of bytes to reserve.
+ */
+void dravex::arena::reserve(const std::size_t size)
+{
+    if (this->head_ != nullptr && this->head_->size_ - this->head_->used_ >= size)
+        return;
+
+    const auto bytes = std::max(size, block_size);
+
+    auto block   = static_cast<block_t*>(::operator new(sizeof(block_t) + bytes));
+    block->prev_ = this->head_;
+    block->size_ = bytes;
+    block->used_ = 0;
+
+    this->head_ = block;
+    this->reserved_ += bytes;
+    this->blocks_++;
+}
+
+/**
+ * Allocates memory from the arena.
+ *
+ * @param {std::size_t} size - The number of bytes to allocate.
+ * @param {std::size_t} align - The required alignment of the allocation. (Must be a power of two.)
+ * @return {void*} The allocated memory.
+ */
+void* dravex::arena::allocate(const std::size_t size, const std::size_t align)
+{
+    // Ensure the current block can hold the allocation including any alignment padding..
+    this->reserve(size + align - 1);
+
+    auto base        = reinterpret_cast<uintptr_t>(this->head_ + 1);
+    const auto start = (base + this->head_->used_ + align - 1) & ~static_cast<uintptr_t>(align - 1);
+    const auto end   = start + size - base;
+
+    this->used_ += end - this->head_->used_;
+    this->head_->used_ = end;
+
+    return reinterpret_cast<void*>(start);
+}
+
+/**
+ * Shrinks the most recent allocation, returning its unused tail to the arena.
+ *
+ * Has no effect if the given pointer is not the most recent allocation.
+ *
+ * @param {void*} ptr - The allocation to shrink.
+ * @param {std::size_t} size - The current size of the allocation.
+ * @param {std::size_t} new_size - The new size of the allocation.
+ */
+void dravex::arena::shrink(void* ptr, const std::size_t size, const std::size_t new_size)
+{
+    if (this->head_ == nullptr || new_size > size)
+        return;
+
+    const auto base = reinterpret_cast<uintptr_t>(this->head_ + 1);
+    const auto addr = reinterpret_cast<uintptr_t>(ptr);
+    if (addr < base || addr + size - base != this->head_->used_)
+        return;
+
+    this->head_->used_ -= size - new_size;
+    this->used_ -= size - new_size;
+}
+
+/**
+ * Releases all memory held by the arena.
+ */
+void dravex::arena::reset(void)
+{
+    while (this->head_ != nullptr)
+    {
+        auto prev = this->head_->prev_;
+        ::operator delete(this->head_);
+        this->head_ = prev;
+    }
+
+    this->used_     = 0;
+    this->reserved_ = 0;
+    this->blocks_   = 0;
+}
+
+/**
+ * Returns the number of bytes handed out by the arena, including alignment padding.
+ *
+ * @return {std::size_t} The used byte count.
+ */
+std::size_t dravex::arena::get_used(void) const noexcept
+{
+    return this->used_;
+}
+
+/**
+ * Returns the number of bytes reserved by the arena blocks.
+ *
+ * @return {std::size_t} The reserved byte count.
+ */
+std::size_t dravex::arena::get_reserved(void) const noexcept
+{
+    return this->reserved_;
+}
+
+/**
+ * Returns the number of blocks held by the arena.
+ *
+ * @return {std::size_t} The block count.
+ */
+std::size_t dravex::arena::get_block_count(void) const noexcept
+{
+    return this->blocks_;
+}
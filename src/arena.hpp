@@ -0,0 +1,101 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Monotonic memory arena.
+     *
+     * Memory is handed out from large blocks by bumping an offset and is only ever released all at once. Objects
+     * placed in the arena must be trivially destructible as no destructors are invoked on reset.
+     */
+    class arena final
+    {
+        arena(arena const&)            = delete;
+        arena(arena&&)                 = delete;
+        arena& operator=(arena const&) = delete;
+        arena& operator=(arena&&)      = delete;
+
+        /**
+         * Structure definition for the header of an arena block. (The block data follows the header.)
+         */
+        struct block_t
+        {
+            block_t* prev_;
+            std::size_t size_;
+            std::size_t used_;
+        };
+
+        block_t* head_;
+        std::size_t used_;
+        std::size_t reserved_;
+        std::size_t blocks_;
+
+    public:
+        static constexpr std::size_t block_size = 64 * 1024;
+
+        arena(void);
+        ~arena(void);
+
+        auto reserve(const std::size_t size) -> void;
+        auto allocate(const std::size_t size, const std::size_t align) -> void*;
+        auto shrink(void* ptr, const std::size_t size, const std::size_t new_size) -> void;
+        auto reset(void) -> void;
+
+        auto get_used(void) const noexcept -> std::size_t;
+        auto get_reserved(void) const noexcept -> std::size_t;
+        auto get_block_count(void) const noexcept -> std::size_t;
+
+        /**
+         * Allocates a zero-initialized array of the given type from the arena.
+         *
+         * @param {std::size_t} count - The number of elements to allocate.
+         * @return {T*} The allocated array.
+         */
+        template<typename T>
+        auto allocate(const std::size_t count) -> T*
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "arena objects must be trivially destructible");
+
+            auto ptr = this->allocate(sizeof(T) * count, alignof(T));
+            std::memset(ptr, 0, sizeof(T) * count);
+            return static_cast<T*>(ptr);
+        }
+    };
+
+} // namespace dravex
+
+#endif // ARENA_HPP
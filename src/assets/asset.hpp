@@ -32,14 +32,24 @@
 #endif
 
 #include "../defines.hpp"
+#include "../package/package.hpp"
 
 namespace dravex::assets
 {
+    /**
+     * Asset viewer interface.
+     *
+     * Assets are loaded in two phases. decode is invoked on a background worker to read and prepare the asset
+     * data and must not touch ImGui or any Direct3D state used for rendering. (Scratch resources, which are not
+     * bound to the device, may be used.) initialize is then invoked on the main thread to create the Direct3D
+     * and ImGui resources from the decoded data.
+     */
     interface __declspec(novtable) asset
     {
-        virtual bool initialize(IDirect3DDevice9* device, const std::shared_ptr<dravex::fileentry_t>& entry) = 0;
-        virtual void release(void)                                                                           = 0;
-        virtual void render(void)                                                                            = 0;
+        virtual bool decode(dravex::package& pkg, const dravex::fileentry_t* entry)         = 0;
+        virtual bool initialize(IDirect3DDevice9* device, const dravex::fileentry_t* entry) = 0;
+        virtual void release(void)                                                          = 0;
+        virtual void render(void)                                                           = 0;
     };
 
 } // namespace dravex::assets
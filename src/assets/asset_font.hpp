@@ -42,9 +42,16 @@ namespace dravex::assets
      */
     std::map<uint32_t, std::tuple<ImFont*, ImFont*, ImFont*, ImFont*, ImFont*, ImFont*, ImFont*>> fonts;
 
+    /**
+     * Font data referenced by the font atlas. (The atlas does not own it and may rebuild from it later.)
+     */
+    std::vector<dravex::entrybuffer_t> fonts_data;
+
     class asset_font final : public asset
     {
         IDirect3DDevice9* device_;
+        dravex::entrybuffer_t data_;
+        uint32_t checksum_;
         ImFont* font12_;
         ImFont* font18_;
         ImFont* font24_;
@@ -59,6 +66,7 @@ namespace dravex::assets
          */
         asset_font(void)
             : device_{nullptr}
+            , checksum_{0}
             , font12_{nullptr}
             , font18_{nullptr}
             , font24_{nullptr}
@@ -72,20 +80,43 @@ namespace dravex::assets
             this->release();
         }
 
+        /**
+         * Decodes the asset data. (Invoked on a background worker.)
+         *
+         * @param {dravex::package&} pkg - The package holding the asset.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
+         * @return {bool} True on success, false otherwise.
+         */
+        bool decode(dravex::package& pkg, const dravex::fileentry_t* entry)
+        {
+            this->data_ = pkg.get_entry_buffer(entry->index_);
+            if (this->data_ == nullptr)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::font] failed to read asset data..");
+                return false;
+            }
+
+            this->checksum_ = dravex::utils::adler32(this->data_->data(), this->data_->size());
+            return true;
+        }
+
         /**
          * Initializes the asset, preparing it for viewing.
          *
          * @param {IDirect3DDevice9*} device - The Direct3D device pointer.
-         * @param {std::shared_ptr&} entry - The asset entry being loaded.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
          * @return {bool} True on success, false otherwise.
          */
-        bool initialize(IDirect3DDevice9* device, const std::shared_ptr<dravex::fileentry_t>& entry)
+        bool initialize(IDirect3DDevice9* device, const dravex::fileentry_t* entry)
         {
             this->device_ = device;
             this->device_->AddRef();
 
-            const auto data     = dravex::package::instance().get_entry_data(entry->index_);
-            const auto checksum = dravex::utils::adler32(data.data(), data.size());
+            const auto data = std::move(this->data_);
+            if (data == nullptr)
+                return false;
+
+            const auto checksum = this->checksum_;
             const auto iter     = dravex::assets::fonts.find(checksum);
 
             if (iter != dravex::assets::fonts.end())
@@ -103,16 +134,17 @@ namespace dravex::assets
                 ImFontConfig cfg{};
                 cfg.FontDataOwnedByAtlas = false;
 
-                this->font12_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 12.0f, &cfg);
-                this->font18_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 18.0f, &cfg);
-                this->font24_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 24.0f, &cfg);
-                this->font36_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 36.0f, &cfg);
-                this->font48_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 48.0f, &cfg);
-                this->font60_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 60.0f, &cfg);
-                this->font72_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data.data()), data.size(), 72.0f, &cfg);
+                this->font12_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 12.0f, &cfg);
+                this->font18_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 18.0f, &cfg);
+                this->font24_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 24.0f, &cfg);
+                this->font36_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 36.0f, &cfg);
+                this->font48_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 48.0f, &cfg);
+                this->font60_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 60.0f, &cfg);
+                this->font72_ = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(data->data()), data->size(), 72.0f, &cfg);
 
                 ImGui::GetIO().Fonts->Build();
 
+                dravex::assets::fonts_data.push_back(data);
                 dravex::assets::fonts[checksum] = std::make_tuple(
                     this->font12_,
                     this->font18_,
@@ -70,7 +70,7 @@ namespace dravex::assets
     class asset_ogg final : public asset
     {
         IDirect3DDevice9* device_;
-        std::vector<uint8_t> data_;
+        dravex::entrybuffer_t data_;
         stb_vorbis* vorbis_;
         ma_device madevice_;
 
@@ -88,26 +88,47 @@ namespace dravex::assets
             this->release();
         }
 
+        /**
+         * Decodes the asset data. (Invoked on a background worker.)
+         *
+         * @param {dravex::package&} pkg - The package holding the asset.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
+         * @return {bool} True on success, false otherwise.
+         */
+        bool decode(dravex::package& pkg, const dravex::fileentry_t* entry)
+        {
+            this->data_ = pkg.get_entry_buffer(entry->index_);
+            if (this->data_ == nullptr)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::ogg] failed to read asset data..");
+                return false;
+            }
+
+            // Load the vorbis file from memory..
+            this->vorbis_ = stb_vorbis_open_memory(this->data_->data(), this->data_->size(), nullptr, nullptr);
+            if (this->vorbis_ == nullptr)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::ogg] failed to initialize vorbis decoder..");
+                return false;
+            }
+
+            return true;
+        }
+
         /**
          * Initializes the asset, preparing it for viewing.
          *
          * @param {IDirect3DDevice9*} device - The Direct3D device pointer.
-         * @param {std::shared_ptr&} entry - The asset entry being loaded.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
          * @return {bool} True on success, false otherwise.
          */
-        bool initialize(IDirect3DDevice9* device, const std::shared_ptr<dravex::fileentry_t>& entry)
+        bool initialize(IDirect3DDevice9* device, const dravex::fileentry_t* entry)
         {
             this->device_ = device;
             this->device_->AddRef();
-            this->data_ = dravex::package::instance().get_entry_data(entry->index_);
 
-            // Load the vorbis file from memory..
-            this->vorbis_ = stb_vorbis_open_memory(this->data_.data(), this->data_.size(), nullptr, nullptr);
             if (this->vorbis_ == nullptr)
-            {
-                dravex::logging::instance().log(dravex::loglevel::error, "[asset::ogg] failed to initialize vorbis decoder..");
                 return false;
-            }
 
             // Obtain the audio information..
             const auto info = stb_vorbis_get_info(this->vorbis_);
@@ -124,9 +145,10 @@ namespace dravex::assets
             // Initialize the device..
             if (ma_device_init(nullptr, &cfg, &this->madevice_) != MA_SUCCESS)
             {
-                dravex::logging::instance().log(dravex::loglevel::error, "[asset::ogg] failed to initialize miniaudio device..");
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::ogg] failed to initialize miniaudio device..");
 
                 stb_vorbis_close(this->vorbis_);
+                this->vorbis_ = nullptr;
                 return false;
             }
 
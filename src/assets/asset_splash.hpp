@@ -56,26 +56,38 @@ namespace dravex::assets
             this->release();
         }
 
+        /**
+         * Decodes the asset data. (Invoked on a background worker.)
+         *
+         * @param {dravex::package&} pkg - The package holding the asset.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
+         * @return {bool} True on success, false otherwise.
+         */
+        bool decode(dravex::package& pkg, const dravex::fileentry_t* entry)
+        {
+            return true;
+        }
+
         /**
          * Initializes the asset, preparing it for viewing.
          *
          * @param {IDirect3DDevice9*} device - The Direct3D device pointer.
-         * @param {std::shared_ptr&} entry - The asset entry being loaded.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
          * @return {bool} True on success, false otherwise.
          */
-        bool initialize(IDirect3DDevice9* device, const std::shared_ptr<dravex::fileentry_t>& entry)
+        bool initialize(IDirect3DDevice9* device, const dravex::fileentry_t* entry)
         {
             this->device_ = device;
             this->device_->AddRef();
 
             if (FAILED(::D3DXCreateTextureFromResourceExA(device, ::GetModuleHandleA(nullptr), MAKEINTRESOURCE(IDI_APPIMAGE), D3DX_DEFAULT, D3DX_DEFAULT, D3DX_DEFAULT, 0, D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_FILTER_NONE, D3DX_FILTER_NONE, 0, nullptr, nullptr, &this->texture_)))
             {
-                dravex::logging::instance().log(dravex::loglevel::error, "[asset::splash] failed to create application image texture..");
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::splash] failed to create application image texture..");
                 return false;
             }
             if (FAILED(this->texture_->GetLevelDesc(0, &this->desc_)))
             {
-                dravex::logging::instance().log(dravex::loglevel::error, "[asset::splash] failed to obtain application image texture information..");
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::splash] failed to obtain application image texture information..");
                 return false;
             }
 
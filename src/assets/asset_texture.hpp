@@ -40,48 +40,142 @@ namespace dravex::assets
         IDirect3DDevice9* device_;
         IDirect3DTexture9* texture_;
         D3DSURFACE_DESC desc_;
+        std::vector<uint8_t> pixels_; // Decoded A8R8G8B8 pixels, tightly packed..
+        uint32_t width_;
+        uint32_t height_;
         ImVec4 color_;
         float zoom_;
 
     public:
         /**
          * Constructor and Destructor
+         *
+         * @param {IDirect3DDevice9*} device - The Direct3D device pointer. (Used by decode to create its scratch surface.)
          */
-        asset_texture(void)
-            : device_{nullptr}
+        asset_texture(IDirect3DDevice9* device)
+            : device_{device}
             , texture_{nullptr}
             , desc_{}
+            , width_{0}
+            , height_{0}
             , color_{1.0f, 1.0f, 1.0f, 1.0f}
             , zoom_{1.0f}
-        {}
+        {
+            if (this->device_ != nullptr)
+                this->device_->AddRef();
+        }
         ~asset_texture(void)
         {
             this->release();
         }
 
+        /**
+         * Decodes the asset data. (Invoked on a background worker.)
+         *
+         * The image is parsed and converted into a scratch surface, which is not bound to the device state, and
+         * its pixels are copied out so initialize only has to create and fill the texture.
+         *
+         * @param {dravex::package&} pkg - The package holding the asset.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
+         * @return {bool} True on success, false otherwise.
+         */
+        bool decode(dravex::package& pkg, const dravex::fileentry_t* entry)
+        {
+            if (this->device_ == nullptr)
+                return false;
+
+            const auto data = pkg.get_entry_buffer(entry->index_);
+            if (data == nullptr)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to read asset data..");
+                return false;
+            }
+
+            // Obtain the image information..
+            D3DXIMAGE_INFO info{};
+            if (FAILED(::D3DXGetImageInfoFromFileInMemory(data->data(), static_cast<UINT>(data->size()), &info)))
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to obtain image information..");
+                return false;
+            }
+
+            // Decode the image into a scratch surface..
+            IDirect3DSurface9* surface = nullptr;
+            if (FAILED(this->device_->CreateOffscreenPlainSurface(info.Width, info.Height, D3DFMT_A8R8G8B8, D3DPOOL_SCRATCH, &surface, nullptr)))
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to create decode surface..");
+                return false;
+            }
+
+            auto ret = SUCCEEDED(::D3DXLoadSurfaceFromFileInMemory(surface, nullptr, nullptr, data->data(), static_cast<UINT>(data->size()), nullptr, D3DX_FILTER_NONE, 0, nullptr));
+
+            // Copy the decoded pixels out of the surface..
+            D3DLOCKED_RECT rect{};
+            if (ret && SUCCEEDED(surface->LockRect(&rect, nullptr, D3DLOCK_READONLY)))
+            {
+                const auto stride = static_cast<std::size_t>(info.Width) * 4;
+
+                this->pixels_.resize(stride * info.Height);
+                for (uint32_t y = 0; y < info.Height; y++)
+                    std::memcpy(this->pixels_.data() + y * stride, static_cast<const uint8_t*>(rect.pBits) + y * rect.Pitch, stride);
+
+                surface->UnlockRect();
+            }
+            else
+                ret = false;
+
+            SAFE_RELEASE(surface);
+
+            if (!ret)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to decode image data..");
+                return false;
+            }
+
+            this->width_  = info.Width;
+            this->height_ = info.Height;
+
+            return true;
+        }
+
         /**
          * Initializes the asset, preparing it for viewing.
          *
          * @param {IDirect3DDevice9*} device - The Direct3D device pointer.
-         * @param {std::shared_ptr&} entry - The asset entry being loaded.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
          * @return {bool} True on success, false otherwise.
          */
-        bool initialize(IDirect3DDevice9* device, const std::shared_ptr<dravex::fileentry_t>& entry)
+        bool initialize(IDirect3DDevice9* device, const dravex::fileentry_t* entry)
         {
-            this->device_ = device;
-            this->device_->AddRef();
+            // The texture holds its own copy of the pixels once filled..
+            const auto pixels = std::move(this->pixels_);
+            if (pixels.empty())
+                return false;
 
-            const auto data = dravex::package::instance().get_entry_data(entry->index_);
+            // Create the texture and fill it with the decoded pixels..
+            if (FAILED(device->CreateTexture(this->width_, this->height_, 1, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &this->texture_, nullptr)))
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to create texture..");
+                return false;
+            }
 
-            // Load the texture from the asset data..
-            if (FAILED(::D3DXCreateTextureFromFileInMemory(device, data.data(), data.size(), &this->texture_)))
+            D3DLOCKED_RECT rect{};
+            if (FAILED(this->texture_->LockRect(0, &rect, nullptr, 0)))
             {
-                dravex::logging::instance().log(dravex::loglevel::error, "[asset::texture] failed to create texture..");
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to lock texture..");
+                SAFE_RELEASE(this->texture_);
                 return false;
             }
+
+            const auto stride = static_cast<std::size_t>(this->width_) * 4;
+            for (uint32_t y = 0; y < this->height_; y++)
+                std::memcpy(static_cast<uint8_t*>(rect.pBits) + y * rect.Pitch, pixels.data() + y * stride, stride);
+
+            this->texture_->UnlockRect(0);
+
             if (FAILED(this->texture_->GetLevelDesc(0, &this->desc_)))
             {
-                dravex::logging::instance().log(dravex::loglevel::error, "[asset::texture] failed to obtain texture information..");
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::texture] failed to obtain texture information..");
                 return false;
             }
 
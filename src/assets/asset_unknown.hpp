@@ -41,7 +41,7 @@ namespace dravex::assets
     {
         IDirect3DDevice9* device_;
         uint32_t file_type_;
-        std::vector<uint8_t> data_;
+        dravex::entrybuffer_t data_;
         TextEditor editor_;
         TextEditor::LanguageDefinition lang_;
 
@@ -61,20 +61,23 @@ namespace dravex::assets
         }
 
         /**
-         * Initializes the asset, preparing it for viewing.
+         * Decodes the asset data. (Invoked on a background worker.)
          *
-         * @param {IDirect3DDevice9*} device - The Direct3D device pointer.
-         * @param {std::shared_ptr&} entry - The asset entry being loaded.
+         * @param {dravex::package&} pkg - The package holding the asset.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
          * @return {bool} True on success, false otherwise.
          */
-        bool initialize(IDirect3DDevice9* device, const std::shared_ptr<dravex::fileentry_t>& entry)
+        bool decode(dravex::package& pkg, const dravex::fileentry_t* entry)
         {
-            this->device_ = device;
-            this->device_->AddRef();
-            this->data_ = dravex::package::instance().get_entry_data(entry->index_);
+            this->data_ = pkg.get_entry_buffer(entry->index_);
+            if (this->data_ == nullptr)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[asset::unknown] failed to read asset data..");
+                return false;
+            }
 
             // Convert the incoming data to chars..
-            std::vector<char> str(this->data_.begin(), this->data_.end());
+            std::vector<char> str(this->data_->begin(), this->data_->end());
             str.push_back(0x00);
 
             // Setup the editor..
@@ -88,6 +91,21 @@ namespace dravex::assets
             return true;
         }
 
+        /**
+         * Initializes the asset, preparing it for viewing.
+         *
+         * @param {IDirect3DDevice9*} device - The Direct3D device pointer.
+         * @param {dravex::fileentry_t*} entry - The asset entry being loaded.
+         * @return {bool} True on success, false otherwise.
+         */
+        bool initialize(IDirect3DDevice9* device, const dravex::fileentry_t* entry)
+        {
+            this->device_ = device;
+            this->device_->AddRef();
+
+            return this->data_ != nullptr;
+        }
+
         /**
          * Releases the asset resources.
          */
@@ -111,7 +129,8 @@ namespace dravex::assets
                     mem_edit.OptMidColsCount  = 0;
                     mem_edit.OptUpperCaseHex  = true;
                     mem_edit.ReadOnly         = true;
-                    mem_edit.DrawContents(this->data_.data(), this->data_.size());
+                    if (this->data_ != nullptr)
+                        mem_edit.DrawContents(const_cast<uint8_t*>(this->data_->data()), this->data_->size());
                     ImGui::EndTabItem();
                 }
 
@@ -0,0 +1,168 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loader.hpp"
+#include "../logging.hpp"
+#include "../trace.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::assets::loader::loader(void)
+    : pool_{"asset loader", 1}
+    , generation_{0}
+    , loading_{false}
+    , loading_index_{-1}
+    , ready_{nullptr}
+    , ready_index_{-1}
+{}
+dravex::assets::loader::~loader(void)
+{
+    this->cancel();
+}
+
+/**
+ * Returns the singleton instance of this class.
+ *
+ * @return {loader&} The singleton instance of this class.
+ */
+dravex::assets::loader& dravex::assets::loader::instance(void)
+{
+    static loader l;
+    return l;
+}
+
+/**
+ * Starts decoding the given asset in the background, replacing any previous request.
+ *
+ * @param {dravex::packageptr_t&} pkg - The package holding the entry. (Kept alive until the decode has finished.)
+ * @param {int32_t} index - The index of the entry being loaded.
+ * @param {std::shared_ptr} asset - The asset to decode the entry into.
+ */
+void dravex::assets::loader::load(const dravex::packageptr_t& pkg, const int32_t index, const std::shared_ptr<dravex::assets::asset>& asset)
+{
+    this->cancel();
+
+    const auto generation = this->generation_.load();
+    this->loading_index_  = index;
+    this->loading_        = true;
+
+    this->pool_.submit([this, generation, pkg, index, asset]() {
+        // Skip requests that were replaced before starting..
+        if (this->generation_.load() != generation)
+            return;
+
+        dravex::tracespan span{"decode", "asset", index};
+
+        const auto entry   = pkg->get_entry(index);
+        const auto decoded = entry != nullptr && asset->decode(*pkg, entry);
+        if (!decoded)
+            DRAVEX_LOG(dravex::loglevel::error, "[asset] failed to decode asset at index: {}", index);
+
+        // Discard the result if the request was replaced while decoding..
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->generation_.load() != generation)
+            return;
+
+        // Drop assets that failed to decode; they are never initialized..
+        if (!decoded)
+        {
+            this->loading_       = false;
+            this->loading_index_ = -1;
+            return;
+        }
+
+        this->ready_       = asset;
+        this->ready_index_ = index;
+    });
+}
+
+/**
+ * Obtains the asset of the most recent request once it has finished decoding.
+ *
+ * @param {std::shared_ptr&} asset - The decoded asset, ready to be initialized on the main thread.
+ * @param {int32_t&} index - The index of the entry the asset was decoded from.
+ * @return {bool} True if an asset was ready, false otherwise.
+ */
+bool dravex::assets::loader::poll(std::shared_ptr<dravex::assets::asset>& asset, int32_t& index)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (this->ready_ == nullptr)
+        return false;
+
+    asset = std::move(this->ready_);
+    index = this->ready_index_;
+
+    this->ready_       = nullptr;
+    this->ready_index_ = -1;
+    this->loading_     = false;
+
+    return true;
+}
+
+/**
+ * Cancels the current request. (A decode already in progress finishes in the background and is discarded.)
+ */
+void dravex::assets::loader::cancel(void)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    this->generation_++;
+    this->pool_.clear();
+
+    this->ready_         = nullptr;
+    this->ready_index_   = -1;
+    this->loading_       = false;
+    this->loading_index_ = -1;
+}
+
+/**
+ * Blocks until any decode in progress has finished. (Used before closing the package.)
+ */
+void dravex::assets::loader::wait(void)
+{
+    this->pool_.wait();
+}
+
+/**
+ * Returns if an asset is being loaded.
+ *
+ * @return {bool} True if loading, false otherwise.
+ */
+bool dravex::assets::loader::is_loading(void) const
+{
+    return this->loading_;
+}
+
+/**
+ * Returns the index of the entry being loaded.
+ *
+ * @return {int32_t} The entry index if loading, -1 otherwise.
+ */
+int32_t dravex::assets::loader::get_loading_index(void) const
+{
+    return this->loading_ ? this->loading_index_.load() : -1;
+}
@@ -0,0 +1,82 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "../workpool.hpp"
+#include "../package/package.hpp"
+#include "asset.hpp"
+
+namespace dravex::assets
+{
+    /**
+     * Background asset loader.
+     *
+     * Runs the decode phase of assets on a worker thread and hands the decoded asset back to the main thread
+     * to be initialized. Only the most recent request is kept; starting a new load or cancelling makes any
+     * older request stale, dropping it before it starts or discarding its result once it finishes.
+     */
+    class loader final
+    {
+        loader(loader const&)            = delete;
+        loader(loader&&)                 = delete;
+        loader& operator=(loader const&) = delete;
+        loader& operator=(loader&&)      = delete;
+
+        loader(void);
+        ~loader(void);
+
+        dravex::workpool pool_;
+        std::atomic<uint32_t> generation_;
+        std::atomic<bool> loading_;
+        std::atomic<int32_t> loading_index_;
+
+        std::mutex mutex_;
+        std::shared_ptr<dravex::assets::asset> ready_;
+        int32_t ready_index_;
+
+    public:
+        static loader& instance(void);
+
+    public:
+        auto load(const dravex::packageptr_t& pkg, const int32_t index, const std::shared_ptr<dravex::assets::asset>& asset) -> void;
+        auto poll(std::shared_ptr<dravex::assets::asset>& asset, int32_t& index) -> bool;
+        auto cancel(void) -> void;
+        auto wait(void) -> void;
+
+        auto is_loading(void) const -> bool;
+        auto get_loading_index(void) const -> int32_t;
+    };
+
+} // namespace dravex::assets
+
+#endif // ASSET_LOADER_HPP
@@ -0,0 +1,212 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+
+namespace dravex::bench
+{
+    /**
+     * Structure definition for a single benchmark result.
+     */
+    struct result_t
+    {
+        std::string name_;
+        std::string package_;
+        uint32_t threads_;
+        uint64_t iterations_;
+        uint64_t ops_;
+        uint64_t bytes_;
+        double ns_min_;
+        double ns_median_;
+        double ns_mean_;
+        double ns_max_;
+    };
+
+    class harness final
+    {
+        std::vector<result_t> results_;
+        uint64_t iterations_;
+        std::string filter_;
+
+    public:
+        /**
+         * Constructor and Destructor
+         */
+        harness(const uint64_t iterations, const std::string& filter)
+            : iterations_{iterations}
+            , filter_{filter}
+        {}
+        ~harness(void)
+        {}
+
+        /**
+         * Runs the given benchmark function, timing each iteration.
+         *
+         * @param {std::string&} name - The name of the benchmark.
+         * @param {std::string&} package - The package (or data set) the benchmark is running against.
+         * @param {uint32_t} threads - The number of threads the benchmark function uses.
+         * @param {uint64_t} ops - The number of operations performed per iteration.
+         * @param {uint64_t} bytes - The number of bytes processed per iteration.
+         * @param {std::function} func - The benchmark function to invoke once per iteration.
+         */
+        void run(const std::string& name, const std::string& package, const uint32_t threads, const uint64_t ops, const uint64_t bytes, const std::function<void(void)>& func)
+        {
+            if (!this->filter_.empty() && name.find(this->filter_) == std::string::npos)
+                return;
+
+            // Warm up once so the first sample does not pay for one-time costs..
+            func();
+
+            std::vector<double> samples;
+            samples.reserve(this->iterations_);
+
+            for (uint64_t x = 0; x < this->iterations_; x++)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                func();
+                const auto end = std::chrono::steady_clock::now();
+
+                samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+
+            std::sort(samples.begin(), samples.end());
+
+            result_t res{};
+            res.name_       = name;
+            res.package_    = package;
+            res.threads_    = threads;
+            res.iterations_ = this->iterations_;
+            res.ops_        = ops;
+            res.bytes_      = bytes;
+            res.ns_min_     = samples.front();
+            res.ns_median_  = samples[samples.size() / 2];
+            res.ns_mean_    = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+            res.ns_max_     = samples.back();
+
+            std::cerr << std::format("[bench] {:<36} {:<16} threads: {:>2} median: {:>14.0f} ns", name, package, threads, res.ns_median_) << std::endl;
+
+            this->results_.push_back(res);
+        }
+
+        /**
+         * Escapes the given string for use within a JSON document.
+         *
+         * @param {std::string&} str - The string to escape.
+         * @return {std::string} The escaped string.
+         */
+        static std::string escape(const std::string& str)
+        {
+            std::string out;
+            out.reserve(str.size());
+
+            for (const auto c : str)
+            {
+                switch (c)
+                {
+                    case '"':
+                        out += "\\\"";
+                        break;
+                    case '\\':
+                        out += "\\\\";
+                        break;
+                    case '\n':
+                        out += "\\n";
+                        break;
+                    case '\r':
+                        out += "\\r";
+                        break;
+                    case '\t':
+                        out += "\\t";
+                        break;
+                    default:
+                        if (static_cast<uint8_t>(c) < 0x20)
+                            out += std::format("\\u{:04x}", static_cast<uint32_t>(c));
+                        else
+                            out += c;
+                        break;
+                }
+            }
+
+            return out;
+        }
+
+        /**
+         * Writes the collected results as a JSON document to the given stream.
+         *
+         * @param {std::ostream&} stream - The stream to write the results to.
+         */
+        void write_json(std::ostream& stream) const
+        {
+            const auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+            stream << "{\n";
+            stream << "  \"schema\": 1,\n";
+            stream << std::format("  \"timestamp\": {},\n", now);
+            stream << std::format("  \"hardware_concurrency\": {},\n", std::thread::hardware_concurrency());
+            stream << "  \"results\": [\n";
+
+            for (std::size_t x = 0; x < this->results_.size(); x++)
+            {
+                const auto& r = this->results_[x];
+
+                // Derive per-operation and throughput figures from the median sample..
+                const auto ns_per_op   = r.ops_ > 0 ? r.ns_median_ / static_cast<double>(r.ops_) : 0.0;
+                const auto mb_per_sec  = r.bytes_ > 0 && r.ns_median_ > 0 ? (static_cast<double>(r.bytes_) / (1024.0 * 1024.0)) / (r.ns_median_ / 1e9) : 0.0;
+                const auto ops_per_sec = r.ops_ > 0 && r.ns_median_ > 0 ? static_cast<double>(r.ops_) / (r.ns_median_ / 1e9) : 0.0;
+
+                stream << "    {";
+                stream << std::format("\"name\": \"{}\", ", escape(r.name_));
+                stream << std::format("\"package\": \"{}\", ", escape(r.package_));
+                stream << std::format("\"threads\": {}, ", r.threads_);
+                stream << std::format("\"iterations\": {}, ", r.iterations_);
+                stream << std::format("\"ops_per_iteration\": {}, ", r.ops_);
+                stream << std::format("\"bytes_per_iteration\": {}, ", r.bytes_);
+                stream << std::format("\"ns_min\": {:.1f}, ", r.ns_min_);
+                stream << std::format("\"ns_median\": {:.1f}, ", r.ns_median_);
+                stream << std::format("\"ns_mean\": {:.1f}, ", r.ns_mean_);
+                stream << std::format("\"ns_max\": {:.1f}, ", r.ns_max_);
+                stream << std::format("\"ns_per_op\": {:.3f}, ", ns_per_op);
+                stream << std::format("\"ops_per_sec\": {:.1f}, ", ops_per_sec);
+                stream << std::format("\"mb_per_sec\": {:.3f}", mb_per_sec);
+                stream << (x + 1 < this->results_.size() ? "},\n" : "}\n");
+            }
+
+            stream << "  ]\n";
+            stream << "}\n";
+        }
+    };
+
+} // namespace dravex::bench
+
+#endif // BENCH_HARNESS_HPP
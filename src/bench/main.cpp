@@ -0,0 +1,474 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../defines.hpp"
+#include "../binarybuffer.hpp"
+#include "../bufferpool.hpp"
+#include "../logging.hpp"
+#include "../utils.hpp"
+#include "../package/overlay.hpp"
+#include "../package/package.hpp"
+#include "harness.hpp"
+#include "synthetic.hpp"
+
+/**
+ * Globals
+ */
+std::atomic<uint64_t> g_sink{0};
+
+/**
+ * Structure definition for the benchmark command line options.
+ */
+struct options_t
+{
+    std::vector<std::string> packages_;
+    std::string output_;
+    std::string filter_;
+    uint64_t iterations_ = 10;
+    uint32_t threads_    = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t entries_    = 4096;
+    uint32_t sample_     = 4096;
+    bool synthetic_      = true;
+};
+
+/**
+ * Returns an evenly spaced sample of entry indexes from the given package.
+ *
+ * @param {dravex::package&} pkg - The package to sample.
+ * @param {uint32_t} sample - The maximum number of indexes to return.
+ * @return {std::vector} The sampled entry indexes.
+ */
+std::vector<int32_t> sample_indexes(dravex::package& pkg, const uint32_t sample)
+{
+    const auto count = pkg.get_entry_count();
+    const auto step  = std::max<std::size_t>(1, count / std::max<uint32_t>(1, sample));
+
+    std::vector<int32_t> indexes;
+    for (std::size_t x = 0; x < count && indexes.size() < sample; x += step)
+        indexes.push_back(static_cast<int32_t>(x));
+
+    return indexes;
+}
+
+/**
+ * Checks the file types of a synthetic v666 package against the generated entries.
+ *
+ * The v666 format stores the file types as a count of files per type; the first and last entry of each type
+ * are checked so every boundary between the types is covered.
+ *
+ * @param {std::string&} path - The path to the game.pki file of the package.
+ * @param {uint32_t} entry_count - The number of generated entries.
+ * @return {bool} True if the file types match, false otherwise.
+ */
+bool check_file_types(const std::string& path, const uint32_t entry_count)
+{
+    dravex::package pkg;
+    if (!pkg.open(path) || pkg.get_entry_count() != entry_count)
+        return false;
+
+    for (uint32_t x = 0; x < entry_count; x++)
+    {
+        const auto type  = dravex::bench::get_file_type(x, entry_count);
+        const auto first = x == 0 || dravex::bench::get_file_type(x - 1, entry_count) != type;
+        const auto last  = x + 1 == entry_count || dravex::bench::get_file_type(x + 1, entry_count) != type;
+
+        if ((first || last) && pkg.get_entry(static_cast<int32_t>(x))->file_type_ != type)
+        {
+            std::cerr << std::format("[bench] entry {} has file type {}, expected {}.", x, pkg.get_entry(static_cast<int32_t>(x))->file_type_, type) << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Runs the package benchmarks against the given package.
+ *
+ * @param {dravex::bench::harness&} h - The benchmark harness.
+ * @param {options_t&} opts - The benchmark options.
+ * @param {std::string&} label - The label used to identify the package in the results.
+ * @param {std::string&} path - The path to the game.pki file of the package.
+ */
+void bench_package(dravex::bench::harness& h, const options_t& opts, const std::string& label, const std::string& path)
+{
+    dravex::package pkg;
+
+    // Benchmark: package::open
+    h.run("package.open", label, 1, 1, 0, [&]() {
+        g_sink.fetch_add(pkg.open(path) ? 1 : 0, std::memory_order_relaxed);
+    });
+
+    if (!pkg.open(path) || pkg.get_entry_count() == 0)
+    {
+        std::cerr << std::format("[bench] failed to open package; skipping: {}", path) << std::endl;
+        return;
+    }
+
+    // Prepare a shuffled set of lookup indexes to avoid measuring purely sequential access..
+    std::vector<int32_t> lookups(4096);
+    std::mt19937 rng{1337};
+    for (auto& i : lookups)
+        i = static_cast<int32_t>(rng() % pkg.get_entry_count());
+
+    std::vector<uint32_t> offsets;
+    for (const auto i : lookups)
+        offsets.push_back(pkg.get_entry(i)->string_offset_);
+
+    // Benchmark: package::get_entry
+    h.run("package.get_entry", label, 1, lookups.size(), 0, [&]() {
+        uint64_t sum = 0;
+        for (const auto i : lookups)
+            sum += pkg.get_entry(i)->size_uncompressed_;
+        g_sink.fetch_add(sum, std::memory_order_relaxed);
+    });
+
+    // Benchmark: package::get_string
+    h.run("package.get_string", label, 1, offsets.size(), 0, [&]() {
+        uint64_t sum = 0;
+        for (const auto o : offsets)
+            sum += reinterpret_cast<uintptr_t>(pkg.get_string(o));
+        g_sink.fetch_add(sum, std::memory_order_relaxed);
+    });
+
+    // Benchmark: package::get_entry_name and package::for_each_sorted_entry (verbatim and front-coded names)..
+    for (const auto compact : {false, true})
+    {
+        pkg.set_compact_names(compact);
+        if (!pkg.open(path))
+            continue;
+
+        const auto name_label = compact ? label + "-compact" : label;
+
+        h.run("package.get_entry_name", name_label, 1, lookups.size(), 0, [&]() {
+            std::string name;
+            uint64_t sum = 0;
+            for (const auto i : lookups)
+            {
+                pkg.get_entry_name(i, name);
+                sum += name.size();
+            }
+            g_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+        h.run("package.for_each_sorted_entry", name_label, 1, pkg.get_entry_count(), 0, [&]() {
+            uint64_t sum = 0;
+            pkg.for_each_sorted_entry([&sum](const uint32_t, const std::string_view name) -> bool {
+                sum += name.size();
+                return true;
+            });
+            g_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+
+    pkg.set_compact_names(false);
+    if (!pkg.open(path))
+        return;
+
+    // Prepare the sample of entries to read the data of..
+    const auto indexes = sample_indexes(pkg, opts.sample_);
+
+    uint64_t bytes = 0;
+    for (const auto i : indexes)
+        bytes += pkg.get_entry(i)->size_uncompressed_;
+
+    // Benchmark: package::get_entry_data (single and multi-threaded)..
+    for (uint32_t threads = 1; threads <= opts.threads_; threads *= 2)
+    {
+        h.run("package.get_entry_data", label, threads, indexes.size(), bytes, [&]() {
+            std::atomic<std::size_t> next{0};
+
+            const auto worker = [&]() {
+                uint64_t sum = 0;
+                for (auto x = next++; x < indexes.size(); x = next++)
+                    sum += pkg.get_entry_data(indexes[x]).size();
+                g_sink.fetch_add(sum, std::memory_order_relaxed);
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32_t x = 1; x < threads; x++)
+                workers.emplace_back(worker);
+
+            worker();
+
+            for (auto& t : workers)
+                t.join();
+        });
+    }
+
+    // Benchmark: package::find_entry and overlay::find_entry (the package stacked over itself, replacing every entry)..
+    {
+        std::vector<std::string> paths(lookups.size());
+        for (std::size_t x = 0; x < lookups.size(); x++)
+            pkg.get_entry_name(lookups[x], paths[x]);
+
+        h.run("package.find_entry", label, 1, paths.size(), 0, [&]() {
+            uint64_t sum = 0;
+            for (const auto& p : paths)
+                sum += static_cast<uint32_t>(pkg.find_entry(p));
+            g_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+
+        auto base  = dravex::package::create();
+        auto patch = dravex::package::create();
+        auto view  = dravex::overlay::create();
+        if (base->open(path) && patch->open(path))
+        {
+            view->add_layer(base);
+            view->add_layer(patch);
+
+            h.run("overlay.build", label, 1, base->get_entry_count() + patch->get_entry_count(), 0, [&]() {
+                g_sink.fetch_add(view->build() ? 1 : 0, std::memory_order_relaxed);
+            });
+            h.run("overlay.find_entry", label, 1, paths.size(), 0, [&]() {
+                uint64_t sum = 0;
+                for (const auto& p : paths)
+                    sum += static_cast<uint32_t>(view->find_entry(p));
+                g_sink.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    // Benchmark: package::get_entry_data with an independent package per thread..
+    for (uint32_t threads = 2; threads <= opts.threads_; threads *= 2)
+    {
+        std::vector<dravex::packageptr_t> pkgs;
+        for (uint32_t x = 0; x < threads; x++)
+        {
+            auto p = dravex::package::create();
+            if (p->open(path))
+                pkgs.push_back(std::move(p));
+        }
+
+        if (pkgs.size() != threads)
+            continue;
+
+        h.run("package.get_entry_data.packages", label, threads, indexes.size(), bytes, [&]() {
+            std::atomic<std::size_t> next{0};
+
+            const auto worker = [&](dravex::package& p) {
+                uint64_t sum = 0;
+                for (auto x = next++; x < indexes.size(); x = next++)
+                    sum += p.get_entry_data(indexes[x]).size();
+                g_sink.fetch_add(sum, std::memory_order_relaxed);
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32_t x = 1; x < threads; x++)
+                workers.emplace_back(worker, std::ref(*pkgs[x]));
+
+            worker(*pkgs[0]);
+
+            for (auto& t : workers)
+                t.join();
+        });
+    }
+
+    pkg.close();
+}
+
+/**
+ * Runs the standalone utility and binary buffer benchmarks.
+ *
+ * @param {dravex::bench::harness&} h - The benchmark harness.
+ * @param {options_t&} opts - The benchmark options.
+ */
+void bench_utils(dravex::bench::harness& h, const options_t& opts)
+{
+    std::mt19937 rng{42};
+
+    // Prepare a large compressed block of data..
+    const auto raw = dravex::bench::generate_data(rng, 8 * 1024 * 1024);
+
+    auto csize = ::compressBound(static_cast<uLong>(raw.size()));
+    std::vector<uint8_t> compressed(csize);
+    ::compress2(compressed.data(), &csize, raw.data(), static_cast<uLong>(raw.size()), Z_DEFAULT_COMPRESSION);
+    compressed.resize(csize);
+
+    // Benchmark: utils::inflate
+    h.run("utils.inflate", "synthetic", 1, 1, raw.size(), [&]() {
+        std::vector<uint8_t> out;
+        dravex::utils::inflate(compressed.data(), compressed.size(), 0, out);
+        g_sink.fetch_add(out.size(), std::memory_order_relaxed);
+    });
+    h.run("utils.inflate", "pooled", 1, 1, raw.size(), [&]() {
+        dravex::pooledbuffer out{raw.size()};
+        out.get().clear();
+        dravex::utils::inflate(compressed.data(), compressed.size(), 0, out.get());
+        g_sink.fetch_add(out.get().size(), std::memory_order_relaxed);
+    });
+
+    // Prepare a string table..
+    auto entries     = dravex::bench::generate_entries(std::max<uint32_t>(opts.entries_, 1), 7);
+    const auto table = dravex::bench::build_string_table(entries);
+
+    // Benchmark: utils::parse_strings
+    h.run("utils.parse_strings", "synthetic", 1, entries.size(), table.size(), [&]() {
+        std::map<uint32_t, std::string> strings;
+        dravex::utils::parse_strings(table, strings);
+        g_sink.fetch_add(strings.size(), std::memory_order_relaxed);
+    });
+
+    // Benchmark: binarybuffer::read<uint32_t>
+    {
+        const uint32_t count = 1024 * 1024;
+        std::vector<uint8_t> data(count * sizeof(uint32_t));
+        for (auto& b : data)
+            b = static_cast<uint8_t>(rng());
+
+        dravex::binarybuffer buffer(data.data(), data.size());
+        h.run("binarybuffer.read_trivial", "synthetic", 1, count, data.size(), [&]() {
+            buffer.reset();
+            uint64_t sum = 0;
+            for (uint32_t x = 0; x < count; x++)
+                sum += buffer.read<uint32_t>();
+            g_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+
+    // Benchmark: binarybuffer::read<std::vector<T>>
+    {
+        const uint32_t count = 65536;
+        std::vector<uint8_t> data(count * sizeof(dravex::v666::diskpkgfileinfo_t));
+        for (auto& b : data)
+            b = static_cast<uint8_t>(rng());
+
+        dravex::binarybuffer buffer(data.data(), data.size());
+        h.run("binarybuffer.read_vector", "synthetic", 1, count, data.size(), [&]() {
+            buffer.reset();
+            g_sink.fetch_add(buffer.read<std::vector<dravex::v666::diskpkgfileinfo_t>>(count).size(), std::memory_order_relaxed);
+        });
+    }
+
+    // Benchmark: binarybuffer::read<std::string>
+    {
+        dravex::binarybuffer buffer(reinterpret_cast<const uint8_t*>(table.data()), table.size());
+        h.run("binarybuffer.read_string", "synthetic", 1, entries.size(), table.size(), [&]() {
+            buffer.reset();
+            uint64_t sum = 0;
+            for (std::size_t x = 0; x < entries.size(); x++)
+                sum += buffer.read<std::string>().size();
+            g_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+}
+
+/**
+ * Application entry point.
+ *
+ * @param {int32_t} argc - The argument count passed to the application.
+ * @param {char*[]} argv - The argument array passed to the application.
+ * @return {int32_t} 0 on success, 1 otherwise.
+ */
+int32_t __cdecl main(int32_t argc, char* argv[])
+{
+    options_t opts{};
+
+    // Parse the command line arguments..
+    for (auto x = 1; x < argc; x++)
+    {
+        const std::string arg = argv[x];
+        const auto has_value  = x + 1 < argc;
+
+        if (arg == "--package" && has_value)
+            opts.packages_.push_back(argv[++x]);
+        else if (arg == "--output" && has_value)
+            opts.output_ = argv[++x];
+        else if (arg == "--filter" && has_value)
+            opts.filter_ = argv[++x];
+        else if (arg == "--iterations" && has_value)
+            opts.iterations_ = std::max<uint64_t>(1, std::stoull(argv[++x]));
+        else if (arg == "--threads" && has_value)
+            opts.threads_ = std::max<uint32_t>(1, std::stoul(argv[++x]));
+        else if (arg == "--entries" && has_value)
+            opts.entries_ = std::max<uint32_t>(1, std::stoul(argv[++x]));
+        else if (arg == "--sample" && has_value)
+            opts.sample_ = std::max<uint32_t>(1, std::stoul(argv[++x]));
+        else if (arg == "--no-synthetic")
+            opts.synthetic_ = false;
+        else
+        {
+            std::cerr << "usage: dravex_bench [--package <game.pki>]... [--output <file.json>] [--filter <name>]" << std::endl
+                      << "                    [--iterations <n>] [--threads <n>] [--entries <n>] [--sample <n>] [--no-synthetic]" << std::endl;
+            return 1;
+        }
+    }
+
+    dravex::bench::harness h(opts.iterations_, opts.filter_);
+
+    auto ret = 0;
+
+    // Run the standalone benchmarks..
+    bench_utils(h, opts);
+
+    // Run the synthetic package benchmarks..
+    if (opts.synthetic_)
+    {
+        const auto root = std::filesystem::temp_directory_path() / "dravex_bench";
+
+        if (dravex::bench::write_v118(root / "v118", opts.entries_))
+            bench_package(h, opts, "synthetic-v118", (root / "v118" / "game.pki").string());
+        else
+            std::cerr << "[bench] failed to write synthetic v118 package." << std::endl;
+
+        if (dravex::bench::write_v666(root / "v666", opts.entries_))
+        {
+            if (!check_file_types((root / "v666" / "game.pki").string(), opts.entries_))
+            {
+                std::cerr << "[bench] synthetic v666 package file types do not match the generated entries." << std::endl;
+                ret = 1;
+            }
+
+            bench_package(h, opts, "synthetic-v666", (root / "v666" / "game.pki").string());
+        }
+        else
+            std::cerr << "[bench] failed to write synthetic v666 package." << std::endl;
+
+        std::error_code ec{};
+        std::filesystem::remove_all(root, ec);
+    }
+
+    // Run the real package benchmarks..
+    for (const auto& p : opts.packages_)
+        bench_package(h, opts, std::filesystem::path(p).parent_path().filename().string(), p);
+
+    // Write the results..
+    if (opts.output_.empty())
+        h.write_json(std::cout);
+    else
+    {
+        std::ofstream f(opts.output_, std::ios::out | std::ios::trunc);
+        if (!f.is_open())
+        {
+            std::cerr << std::format("[bench] failed to open output file: {}", opts.output_) << std::endl;
+            return 1;
+        }
+
+        h.write_json(f);
+    }
+
+    return ret;
+}
@@ -0,0 +1,323 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BENCH_SYNTHETIC_HPP
+#define BENCH_SYNTHETIC_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "../package/v118.hpp"
+#include "../package/v666.hpp"
+#include "zlib.h"
+
+namespace dravex::bench
+{
+    /**
+     * Structure definition for a generated synthetic file entry.
+     */
+    struct syntheticentry_t
+    {
+        std::string name_;
+        std::vector<uint8_t> data_;
+        std::vector<uint8_t> data_compressed_;
+        uint32_t file_type_;
+        uint32_t string_offset_;
+        uint32_t data_offset_;
+        uint32_t checksum_;
+        bool is_compressed_;
+    };
+
+    /**
+     * Generates pseudo-random, text-like data that compresses similar to the games script files.
+     *
+     * @param {std::mt19937&} rng - The random number generator.
+     * @param {std::size_t} size - The size of the data to generate.
+     * @return {std::vector} The generated data.
+     */
+    static std::vector<uint8_t> generate_data(std::mt19937& rng, const std::size_t size)
+    {
+        static constexpr const char* words[] = {
+            "Actor", "Item", "Skill", "Monster", "Texture", "Model", "Zone", "Spawn",
+            "Value", "Level", "Damage", "Health", "Mana", "Effect", "Sound", "Layer",
+            "= ", "{ ", "} ", "; ", "0 ", "1 ", "true ", "false ", "\r\n", "\t"};
+
+        std::vector<uint8_t> data;
+        data.reserve(size);
+
+        while (data.size() < size)
+        {
+            // Mix words with some binary noise to avoid overly ideal compression ratios..
+            if ((rng() % 8) == 0)
+                data.push_back(static_cast<uint8_t>(rng() & 0xFF));
+            else
+            {
+                const auto word = words[rng() % _countof(words)];
+                data.insert(data.end(), word, word + ::strlen(word));
+            }
+        }
+
+        data.resize(size);
+        return data;
+    }
+
+    /**
+     * Returns the file type of the given synthetic entry. (Entries are spread evenly over the 21 file types, in order.)
+     *
+     * @param {uint32_t} index - The entry index.
+     * @param {uint32_t} entry_count - The number of entries.
+     * @return {uint32_t} The file type.
+     */
+    static uint32_t get_file_type(const uint32_t index, const uint32_t entry_count)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(index) * 21) / entry_count);
+    }
+
+    /**
+     * Generates the set of synthetic file entries used to build a synthetic package.
+     *
+     * @param {uint32_t} entry_count - The number of entries to generate.
+     * @param {uint32_t} seed - The random number generator seed.
+     * @return {std::vector} The generated entries.
+     */
+    static std::vector<syntheticentry_t> generate_entries(const uint32_t entry_count, const uint32_t seed)
+    {
+        static constexpr const char* dirs[] = {
+            "data/actors/", "data/items/", "data/skills/", "data/textures/ui/",
+            "data/textures/world/", "data/sounds/", "data/zones/", "data/shaders/"};
+
+        std::mt19937 rng{seed};
+        std::vector<syntheticentry_t> entries(entry_count);
+
+        for (uint32_t x = 0; x < entry_count; x++)
+        {
+            auto& e = entries[x];
+
+            // Entries are grouped by file type, matching how the real packages are ordered..
+            e.file_type_ = get_file_type(x, entry_count);
+            e.name_      = std::format("{}entry_{:06d}", dirs[rng() % _countof(dirs)], x);
+
+            // Mostly small files with the occasional large one..
+            const auto size = (rng() % 16) == 0
+                                  ? 64 * 1024 + (rng() % (512 * 1024))
+                                  : 256 + (rng() % (16 * 1024));
+
+            e.data_          = generate_data(rng, size);
+            e.is_compressed_ = (rng() % 4) != 0;
+            e.checksum_      = ::adler32_z(::adler32_z(0L, Z_NULL, 0), e.data_.data(), e.data_.size());
+
+            if (e.is_compressed_)
+            {
+                auto dsize = ::compressBound(static_cast<uLong>(e.data_.size()));
+                e.data_compressed_.resize(dsize);
+                ::compress2(e.data_compressed_.data(), &dsize, e.data_.data(), static_cast<uLong>(e.data_.size()), Z_DEFAULT_COMPRESSION);
+                e.data_compressed_.resize(dsize);
+            }
+        }
+
+        return entries;
+    }
+
+    /**
+     * Builds the string table for the given entries, updating each entries string offset.
+     *
+     * @param {std::vector&} entries - The entries to build the string table for.
+     * @return {std::vector} The string table data.
+     */
+    static std::vector<char> build_string_table(std::vector<syntheticentry_t>& entries)
+    {
+        std::vector<char> table;
+        for (auto& e : entries)
+        {
+            e.string_offset_ = static_cast<uint32_t>(table.size());
+            table.insert(table.end(), e.name_.begin(), e.name_.end());
+            table.push_back('\0');
+        }
+        return table;
+    }
+
+    /**
+     * Writes the game.pkg data file for the given entries, updating each entries data offset.
+     *
+     * @param {std::filesystem::path&} path - The path to the game.pkg file to write.
+     * @param {uint8_t*} guid - The package guid.
+     * @param {std::vector&} entries - The entries to write.
+     * @return {bool} True on success, false otherwise.
+     */
+    static bool write_data_file(const std::filesystem::path& path, const uint8_t* guid, std::vector<syntheticentry_t>& entries)
+    {
+        FILE* f = nullptr;
+        if (::fopen_s(&f, path.string().c_str(), "wb") != ERROR_SUCCESS)
+            return false;
+
+        ::fwrite(guid, 1, 16, f);
+
+        uint32_t offset = 16;
+        for (auto& e : entries)
+        {
+            const auto& data = e.is_compressed_ ? e.data_compressed_ : e.data_;
+
+            e.data_offset_ = offset;
+            ::fwrite(data.data(), 1, data.size(), f);
+
+            offset += static_cast<uint32_t>(data.size());
+        }
+
+        ::fclose(f);
+        return true;
+    }
+
+    /**
+     * Writes a synthetic v118 client package to the given directory.
+     *
+     * @param {std::filesystem::path&} dir - The directory to write the game.pki and game.pkg files into.
+     * @param {uint32_t} entry_count - The number of entries to generate.
+     * @return {bool} True on success, false otherwise.
+     */
+    static bool write_v118(const std::filesystem::path& dir, const uint32_t entry_count)
+    {
+        std::error_code ec{};
+        std::filesystem::create_directories(dir, ec);
+
+        auto entries            = generate_entries(entry_count, 118);
+        const auto string_table = build_string_table(entries);
+
+        const uint8_t guid[16] = {0x11, 0x08, 0x11, 0x08, 0x11, 0x08, 0x11, 0x08, 0x11, 0x08, 0x11, 0x08, 0x11, 0x08, 0x11, 0x08};
+        if (!write_data_file(dir / "game.pkg", guid, entries))
+            return false;
+
+        // Prepare the on-disk entry table..
+        std::vector<dravex::v118::diskpkgfileinfo_t> disk(entry_count);
+        for (uint32_t x = 0; x < entry_count; x++)
+        {
+            const auto& e                  = entries[x];
+            disk[x]                        = {};
+            disk[x].string_offset_         = e.string_offset_;
+            disk[x].flags_                 = static_cast<uint8_t>((e.file_type_ & 0x3F) | (e.is_compressed_ ? 0x40 : 0x00));
+            disk[x].data_offset_           = e.data_offset_;
+            disk[x].checksum_decompressed_ = e.checksum_;
+            disk[x].size_decompressed_     = static_cast<uint32_t>(e.data_.size());
+            disk[x].checksum_compressed_   = e.checksum_;
+            disk[x].size_compressed_       = static_cast<uint32_t>(e.is_compressed_ ? e.data_compressed_.size() : e.data_.size());
+        }
+
+        // Prepare the header information..
+        const uint32_t version             = 2;
+        const uint32_t entry_offset        = 4 + 16 + 16;
+        const uint32_t string_table_size   = static_cast<uint32_t>(string_table.size());
+        const uint32_t string_table_offset = entry_offset + static_cast<uint32_t>(disk.size() * sizeof(dravex::v118::diskpkgfileinfo_t));
+
+        FILE* f = nullptr;
+        if (::fopen_s(&f, (dir / "game.pki").string().c_str(), "wb") != ERROR_SUCCESS)
+            return false;
+
+        ::fwrite(&version, 4, 1, f);
+        ::fwrite(guid, 1, 16, f);
+        ::fwrite(&entry_count, 4, 1, f);
+        ::fwrite(&entry_offset, 4, 1, f);
+        ::fwrite(&string_table_size, 4, 1, f);
+        ::fwrite(&string_table_offset, 4, 1, f);
+        ::fwrite(disk.data(), sizeof(dravex::v118::diskpkgfileinfo_t), disk.size(), f);
+        ::fwrite(string_table.data(), 1, string_table.size(), f);
+        ::fclose(f);
+
+        return true;
+    }
+
+    /**
+     * Writes a synthetic v666 client package to the given directory.
+     *
+     * @param {std::filesystem::path&} dir - The directory to write the game.pki and game.pkg files into.
+     * @param {uint32_t} entry_count - The number of entries to generate.
+     * @return {bool} True on success, false otherwise.
+     */
+    static bool write_v666(const std::filesystem::path& dir, const uint32_t entry_count)
+    {
+        std::error_code ec{};
+        std::filesystem::create_directories(dir, ec);
+
+        auto entries            = generate_entries(entry_count, 666);
+        const auto string_table = build_string_table(entries);
+
+        const uint8_t guid[16] = {0x66, 0x06, 0x66, 0x06, 0x66, 0x06, 0x66, 0x06, 0x66, 0x06, 0x66, 0x06, 0x66, 0x06, 0x66, 0x06};
+        if (!write_data_file(dir / "game.pkg", guid, entries))
+            return false;
+
+        // Prepare the file type sizes table..
+        uint32_t blocks[21]{};
+        for (const auto& e : entries)
+            blocks[std::min<uint32_t>(e.file_type_, 20)]++;
+
+        // Prepare the on-disk entry table..
+        std::vector<dravex::v666::diskpkgfileinfo_t> disk(entry_count);
+        for (uint32_t x = 0; x < entry_count; x++)
+        {
+            const auto& e              = entries[x];
+            disk[x]                    = {};
+            disk[x].string_offset_     = e.string_offset_;
+            disk[x].checksum_          = e.checksum_;
+            disk[x].size_compressed_   = static_cast<uint32_t>(e.is_compressed_ ? e.data_compressed_.size() : e.data_.size());
+            disk[x].data_offset_       = e.data_offset_;
+            disk[x].size_decompressed_ = static_cast<uint32_t>(e.data_.size());
+            disk[x].is_compressed_     = e.is_compressed_ ? 1 : 0;
+        }
+
+        // Prepare the index data that is stored compressed..
+        const auto string_table_size = static_cast<uint32_t>(string_table.size());
+
+        std::vector<uint8_t> index;
+        index.insert(index.end(), reinterpret_cast<const uint8_t*>(blocks), reinterpret_cast<const uint8_t*>(blocks) + sizeof(blocks));
+        index.insert(index.end(), reinterpret_cast<const uint8_t*>(disk.data()), reinterpret_cast<const uint8_t*>(disk.data()) + disk.size() * sizeof(dravex::v666::diskpkgfileinfo_t));
+        index.insert(index.end(), reinterpret_cast<const uint8_t*>(&string_table_size), reinterpret_cast<const uint8_t*>(&string_table_size) + 4);
+        index.insert(index.end(), string_table.begin(), string_table.end());
+
+        auto csize = ::compressBound(static_cast<uLong>(index.size()));
+        std::vector<uint8_t> index_compressed(csize);
+        ::compress2(index_compressed.data(), &csize, index.data(), static_cast<uLong>(index.size()), Z_DEFAULT_COMPRESSION);
+        index_compressed.resize(csize);
+
+        const uint32_t version1 = 3;
+        const uint32_t version2 = 666;
+
+        FILE* f = nullptr;
+        if (::fopen_s(&f, (dir / "game.pki").string().c_str(), "wb") != ERROR_SUCCESS)
+            return false;
+
+        ::fwrite(&version1, 4, 1, f);
+        ::fwrite(&version2, 4, 1, f);
+        ::fwrite(guid, 1, 16, f);
+        ::fwrite(index_compressed.data(), 1, index_compressed.size(), f);
+        ::fclose(f);
+
+        return true;
+    }
+
+} // namespace dravex::bench
+
+#endif // BENCH_SYNTHETIC_HPP
@@ -0,0 +1,162 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "bufferpool.hpp"
+#include "stats.hpp"
+
+namespace dravex
+{
+    /**
+     * Structure definition for the free lists of a single thread.
+     */
+    struct poolcache_t
+    {
+        std::array<std::vector<dravex::bytebuffer_t>, dravex::bufferpool::class_count> free_;
+        std::size_t retained_; // Capacity of the buffers held by the free lists..
+
+        poolcache_t(void)
+            : retained_{0}
+        {
+            // Reserve the free lists up front so returning a buffer never allocates..
+            for (auto& list : this->free_)
+                list.reserve(dravex::bufferpool::class_depth);
+        }
+    };
+
+    /**
+     * Returns the free lists of the calling thread.
+     *
+     * @return {poolcache_t&} The free lists.
+     */
+    static poolcache_t& get_local_pool(void)
+    {
+        thread_local poolcache_t pool;
+        return pool;
+    }
+
+} // namespace dravex
+
+/**
+ * Returns the size class that can hold a buffer of the given size.
+ *
+ * @param {std::size_t} size - The buffer size.
+ * @return {std::size_t} The size class, class_count if the size is too large to be pooled.
+ */
+std::size_t dravex::bufferpool::get_class(const std::size_t size)
+{
+    std::size_t cls = 0;
+    while (cls < class_count && get_class_size(cls) < size)
+        cls++;
+    return cls;
+}
+
+/**
+ * Returns the buffer capacity of the given size class.
+ *
+ * @param {std::size_t} cls - The size class.
+ * @return {std::size_t} The buffer capacity.
+ */
+std::size_t dravex::bufferpool::get_class_size(const std::size_t cls)
+{
+    return static_cast<std::size_t>(1) << (cls + class_min_shift);
+}
+
+/**
+ * Takes a buffer of at least the given size from the calling threads pool.
+ *
+ * The buffer contents are uninitialised; resizing a recycled buffer does not zero it.
+ *
+ * @param {std::size_t} size - The buffer size.
+ * @return {dravex::bytebuffer_t} The buffer, resized to the given size.
+ */
+dravex::bytebuffer_t dravex::bufferpool::acquire(const std::size_t size)
+{
+    // Empty buffers are never pooled..
+    if (size == 0)
+        return {};
+
+    const auto cls = get_class(size);
+
+    // Buffers too large to pool are allocated as-is..
+    if (cls >= class_count)
+    {
+        dravex::stats::instance().add(dravex::counter::pool_misses, 1);
+        return dravex::bytebuffer_t(size);
+    }
+
+    auto& pool = get_local_pool();
+    auto& list = pool.free_[cls];
+    if (!list.empty())
+    {
+        auto buffer = std::move(list.back());
+        list.pop_back();
+        pool.retained_ -= buffer.capacity();
+        buffer.resize(size);
+
+        dravex::stats::instance().add(dravex::counter::pool_hits, 1);
+        return buffer;
+    }
+
+    dravex::bytebuffer_t buffer;
+    buffer.reserve(get_class_size(cls));
+    buffer.resize(size);
+
+    dravex::stats::instance().add(dravex::counter::pool_misses, 1);
+    return buffer;
+}
+
+/**
+ * Returns a buffer to the calling threads pool.
+ *
+ * The buffer is filed under the largest size class its capacity can hold. It is freed instead if it is
+ * too small or too large to be pooled, if the free list of its class is full, or if keeping it would
+ * exceed the bytes retained by the calling thread.
+ *
+ * @param {dravex::bytebuffer_t&&} buffer - The buffer to return.
+ */
+void dravex::bufferpool::release(dravex::bytebuffer_t&& buffer)
+{
+    const auto capacity = buffer.capacity();
+    if (capacity < get_class_size(0))
+        return;
+
+    auto cls = get_class(capacity);
+    if (cls >= class_count)
+        return;
+    if (get_class_size(cls) > capacity)
+        cls--;
+
+    auto& pool = get_local_pool();
+    auto& list = pool.free_[cls];
+    if (list.size() >= class_depth || pool.retained_ + capacity > retained_max)
+        return;
+
+    pool.retained_ += capacity;
+
+    buffer.clear();
+    list.push_back(std::move(buffer));
+}
@@ -0,0 +1,147 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BUFFERPOOL_HPP
+#define BUFFERPOOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Allocator that default-initialises the elements constructed without arguments.
+     *
+     * Growing a byte buffer with this allocator leaves the new bytes uninitialised instead of zeroing them; the
+     * buffers are always overwritten by the data read into them.
+     */
+    template<typename T>
+    struct defaultallocator_t : std::allocator<T>
+    {
+        template<typename U>
+        struct rebind
+        {
+            using other = defaultallocator_t<U>;
+        };
+
+        defaultallocator_t(void) noexcept = default;
+
+        template<typename U>
+        defaultallocator_t(const defaultallocator_t<U>&) noexcept
+        {}
+
+        template<typename U>
+        void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new (static_cast<void*>(ptr)) U;
+        }
+
+        template<typename U, typename... Args>
+        void construct(U* ptr, Args&&... args)
+        {
+            ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+        }
+    };
+
+    /**
+     * Byte buffer that grows without zeroing its new contents.
+     */
+    using bytebuffer_t = std::vector<uint8_t, dravex::defaultallocator_t<uint8_t>>;
+
+    /**
+     * Size-classed, thread-local pool of byte buffers.
+     *
+     * Buffers are grouped into power of two size classes. Each thread keeps a small free list per class, so
+     * acquiring and releasing buffers on the same thread never touches the heap once the pool is warm. The
+     * buffers kept by a thread are bounded by retained_max bytes across all classes.
+     */
+    class bufferpool final
+    {
+    public:
+        static constexpr std::size_t class_min_shift = 12;                // 4KB
+        static constexpr std::size_t class_count     = 15;                // 4KB - 64MB
+        static constexpr std::size_t class_depth     = 4;                 // Buffers kept per class, per thread.
+        static constexpr std::size_t retained_max    = 128 * 1024 * 1024; // Bytes kept across all classes, per thread.
+
+        static auto get_class(const std::size_t size) -> std::size_t;
+        static auto get_class_size(const std::size_t cls) -> std::size_t;
+
+        static auto acquire(const std::size_t size) -> dravex::bytebuffer_t;
+        static auto release(dravex::bytebuffer_t&& buffer) -> void;
+    };
+
+    /**
+     * Scoped buffer that is taken from, and returned to, the calling threads buffer pool.
+     */
+    class pooledbuffer final
+    {
+        pooledbuffer(pooledbuffer const&)            = delete;
+        pooledbuffer(pooledbuffer&&)                 = delete;
+        pooledbuffer& operator=(pooledbuffer const&) = delete;
+        pooledbuffer& operator=(pooledbuffer&&)      = delete;
+
+        dravex::bytebuffer_t buffer_;
+
+    public:
+        /**
+         * Constructor
+         *
+         * @param {dravex::bytebuffer_t&&} buffer - The buffer to take. (Returned to the pool on destruction.)
+         */
+        pooledbuffer(dravex::bytebuffer_t&& buffer)
+            : buffer_{std::move(buffer)}
+        {}
+        /**
+         * Constructor and Destructor
+         *
+         * @param {std::size_t} size - The initial size of the buffer. (Its contents are uninitialised.)
+         */
+        pooledbuffer(const std::size_t size)
+            : buffer_{dravex::bufferpool::acquire(size)}
+        {}
+        ~pooledbuffer(void)
+        {
+            dravex::bufferpool::release(std::move(this->buffer_));
+        }
+
+        /**
+         * Returns the underlying buffer.
+         *
+         * @return {dravex::bytebuffer_t&} The buffer.
+         */
+        auto get(void) noexcept -> dravex::bytebuffer_t&
+        {
+            return this->buffer_;
+        }
+    };
+
+} // namespace dravex
+
+#endif // BUFFERPOOL_HPP
@@ -0,0 +1,555 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../defines.hpp"
+#include "../logging.hpp"
+#include "../package/entryreader.hpp"
+#include "../package/extractor.hpp"
+#include "../package/package.hpp"
+#include "commands.hpp"
+
+namespace
+{
+    /**
+     * Structure definition for the result of a single benchmark scenario.
+     */
+    struct scenario_t
+    {
+        std::string name_;
+        uint32_t threads_;
+        uint64_t entries_;
+        uint64_t bytes_;
+        uint64_t calls_;
+        double seconds_;
+        std::vector<double> latencies_;
+    };
+
+    /**
+     * Enumeration of the methods used to drop the page cache.
+     */
+    enum class dropmethod
+    {
+        none,
+        standby,
+        files,
+    };
+
+    /**
+     * Attempts to purge the system standby list. (Requires SeProfileSingleProcessPrivilege.)
+     *
+     * @return {bool} True on success, false otherwise.
+     */
+    bool purge_standby_list(void)
+    {
+        HANDLE token = nullptr;
+        if (!::OpenProcessToken(::GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+            return false;
+
+        TOKEN_PRIVILEGES tp{};
+        tp.PrivilegeCount           = 1;
+        tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+        const auto enabled = ::LookupPrivilegeValueA(nullptr, SE_PROF_SINGLE_PROCESS_NAME, &tp.Privileges[0].Luid) &&
+                             ::AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr) &&
+                             ::GetLastError() != ERROR_NOT_ALL_ASSIGNED;
+        ::CloseHandle(token);
+
+        if (!enabled)
+            return false;
+
+        using NtSetSystemInformation_t = LONG(NTAPI*)(INT, PVOID, ULONG);
+        const auto func                = reinterpret_cast<NtSetSystemInformation_t>(::GetProcAddress(::GetModuleHandleA("ntdll.dll"), "NtSetSystemInformation"));
+        if (func == nullptr)
+            return false;
+
+        // SystemMemoryListInformation (80), MemoryPurgeStandbyList (4)
+        INT command = 4;
+        return func(80, &command, sizeof(command)) >= 0;
+    }
+
+    /**
+     * Attempts to drop the cached pages of the given files by briefly opening them unbuffered.
+     *
+     * @param {std::vector&} paths - The files to drop from the cache.
+     * @return {bool} True on success, false otherwise.
+     */
+    bool purge_files(const std::vector<std::filesystem::path>& paths)
+    {
+        for (const auto& p : paths)
+        {
+            const auto handle = ::CreateFileA(p.string().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+            if (handle == INVALID_HANDLE_VALUE)
+                return false;
+
+            ::CloseHandle(handle);
+        }
+
+        return true;
+    }
+
+    /**
+     * Drops the page cache for the package files, preferring a full standby list purge when permitted.
+     *
+     * @param {std::vector&} paths - The package files.
+     * @return {dropmethod} The method that was used to drop the cache.
+     */
+    dropmethod drop_caches(const std::vector<std::filesystem::path>& paths)
+    {
+        if (purge_standby_list())
+            return dropmethod::standby;
+        if (purge_files(paths))
+            return dropmethod::files;
+        return dropmethod::none;
+    }
+
+    /**
+     * Returns the given percentile of the (sorted) latency samples.
+     *
+     * @param {std::vector&} samples - The sorted samples.
+     * @param {double} pct - The percentile to return. (0.0 to 1.0)
+     * @return {double} The percentile value.
+     */
+    double percentile(const std::vector<double>& samples, const double pct)
+    {
+        if (samples.empty())
+            return 0.0;
+
+        const auto idx = static_cast<std::size_t>(pct * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(idx, samples.size() - 1)];
+    }
+
+    /**
+     * Reads the given entries using the given number of threads, timing each read.
+     *
+     * @param {std::vector&} pkgs - The packages to read from. (Threads are spread across the packages.)
+     * @param {std::vector&} indexes - The entry indexes to read.
+     * @param {uint32_t} threads - The number of threads to read with.
+     * @param {scenario_t&} res - The scenario result to populate.
+     * @param {bool} cached - True to read through the package entry cache.
+     */
+    void read_entries(const std::vector<dravex::packageptr_t>& pkgs, const std::vector<int32_t>& indexes, const uint32_t threads, scenario_t& res, const bool cached = false)
+    {
+        std::atomic<std::size_t> next{0};
+        std::atomic<uint64_t> bytes{0};
+        std::mutex mutex;
+
+        const auto worker = [&](dravex::package& pkg) {
+            std::vector<double> latencies;
+            uint64_t total = 0;
+
+            for (auto x = next++; x < indexes.size(); x = next++)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                if (cached)
+                {
+                    const auto data = pkg.get_entry_buffer(indexes[x]);
+                    total += data == nullptr ? 0 : data->size();
+                }
+                else
+                    total += pkg.get_entry_data(indexes[x]).size();
+                latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            bytes += total;
+
+            std::lock_guard<std::mutex> lock{mutex};
+            res.latencies_.insert(res.latencies_.end(), latencies.begin(), latencies.end());
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        for (uint32_t x = 1; x < threads; x++)
+            workers.emplace_back(worker, std::ref(*pkgs[x % pkgs.size()]));
+        worker(*pkgs[0]);
+        for (auto& t : workers)
+            t.join();
+
+        res.seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        res.entries_ += indexes.size();
+        res.bytes_ += bytes;
+    }
+
+    /**
+     * Extracts all entries of the package using the given number of threads.
+     *
+     * @param {dravex::packageptr_t&} pkg - The package to extract.
+     * @param {std::filesystem::path&} root - The output directory. (Empty to discard the output.)
+     * @param {uint32_t} threads - The number of threads to extract with.
+     * @param {scenario_t&} res - The scenario result to populate.
+     * @param {dravex::writebackend} backend - The output backend to write with.
+     */
+    void extract_entries(const dravex::packageptr_t& pkg, const std::filesystem::path& root, const uint32_t threads, scenario_t& res, const dravex::writebackend backend = dravex::writebackend::stdio)
+    {
+        dravex::extractoptions_t opts{};
+        opts.root_    = root;
+        opts.threads_ = threads;
+        opts.backend_ = backend;
+        opts.discard_ = root.empty();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        dravex::extractor ext;
+        if (ext.start(pkg, opts))
+            ext.wait();
+
+        res.seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        res.entries_ += ext.get_completed();
+        res.bytes_ += ext.get_bytes_written();
+        res.calls_ += ext.get_write_calls();
+    }
+
+    /**
+     * Reads a small block at each of the given offsets within an entry, timing each seek and read.
+     *
+     * @param {dravex::package&} pkg - The package to read from.
+     * @param {int32_t} index - The entry index.
+     * @param {std::vector&} offsets - The offsets within the uncompressed entry data to read at.
+     * @param {scenario_t&} res - The scenario result to populate.
+     */
+    void seek_entry(dravex::package& pkg, const int32_t index, const std::vector<uint64_t>& offsets, scenario_t& res)
+    {
+        dravex::entryreader reader;
+        if (!reader.open(&pkg, index))
+            return;
+
+        std::array<uint8_t, 4096> block{};
+        uint64_t bytes = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (const auto offset : offsets)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            if (reader.seek(offset))
+                bytes += reader.read(block.data(), block.size());
+            res.latencies_.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+        }
+
+        res.seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        res.entries_ += offsets.size();
+        res.bytes_ += bytes;
+    }
+
+    /**
+     * Prints the given scenario result.
+     *
+     * @param {scenario_t&} res - The scenario result.
+     * @param {bool} json - Flag set if the result should be printed as a JSON line.
+     */
+    void print_scenario(scenario_t& res, const bool json)
+    {
+        std::sort(res.latencies_.begin(), res.latencies_.end());
+
+        const auto mbps = res.seconds_ > 0 ? (static_cast<double>(res.bytes_) / (1024.0 * 1024.0)) / res.seconds_ : 0.0;
+        const auto eps  = res.seconds_ > 0 ? static_cast<double>(res.entries_) / res.seconds_ : 0.0;
+        const auto p50  = percentile(res.latencies_, 0.50);
+        const auto p90  = percentile(res.latencies_, 0.90);
+        const auto p99  = percentile(res.latencies_, 0.99);
+        const auto pmax = res.latencies_.empty() ? 0.0 : res.latencies_.back();
+
+        if (json)
+        {
+            std::cout << std::format(R"({{"scenario": "{}", "threads": {}, "entries": {}, "bytes": {}, "write_calls": {}, "seconds": {:.6f}, "mb_per_sec": {:.3f}, "entries_per_sec": {:.1f}, "p50_us": {:.1f}, "p90_us": {:.1f}, "p99_us": {:.1f}, "max_us": {:.1f}}})",
+                             res.name_, res.threads_, res.entries_, res.bytes_, res.calls_, res.seconds_, mbps, eps, p50, p90, p99, pmax)
+                      << std::endl;
+            return;
+        }
+
+        std::cout << std::format("{:<18} {:>7} {:>10} {:>12.2f} {:>12.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}", res.name_, res.threads_, res.entries_, mbps, eps, p50, p90, p99, pmax) << std::endl;
+    }
+
+} // namespace
+
+/**
+ * Measures open, read and extraction throughput of a package on the current machine.
+ *
+ * @param {dravex::packageptr_t&} handle - The package to measure with.
+ * @param {std::vector&} args - The command arguments.
+ * @return {int32_t} 0 on success, 1 otherwise.
+ */
+int32_t dravex::cli::cmd_bench(const dravex::packageptr_t& handle, const std::vector<std::string>& args)
+{
+    uint64_t threads_value = 0;
+    uint64_t runs_value    = 0;
+    uint64_t reads_value   = 0;
+    if (!get_number(args, "--threads", std::max(1u, std::thread::hardware_concurrency()), std::numeric_limits<uint32_t>::max(), threads_value) ||
+        !get_number(args, "--runs", 3, std::numeric_limits<uint32_t>::max(), runs_value) ||
+        !get_number(args, "--reads", 1000, std::numeric_limits<uint32_t>::max(), reads_value))
+    {
+        print_usage();
+        return 1;
+    }
+
+    const std::filesystem::path pki = args[0];
+    const auto pkg_path             = pki.parent_path() / "game.pkg";
+    const auto max_threads          = std::max<uint32_t>(1, static_cast<uint32_t>(threads_value));
+    const auto runs                 = std::max<uint32_t>(1, static_cast<uint32_t>(runs_value));
+    const auto reads                = std::max<uint32_t>(1, static_cast<uint32_t>(reads_value));
+    const auto drop                 = has_flag(args, "--drop-caches");
+    const auto json                 = has_flag(args, "--json");
+
+    std::filesystem::path out = get_option(args, "--out", "");
+    if (out.empty())
+        out = std::filesystem::temp_directory_path() / "dravex_cli_bench";
+
+    auto& pkg = *handle;
+
+    if (!pkg.open(pki.string()))
+    {
+        std::cout << std::format("[!] Error: failed to open package: {}", pki.string()) << std::endl;
+        return 1;
+    }
+
+    // Prepare the thread counts to measure with..
+    std::vector<uint32_t> thread_counts;
+    for (uint32_t t = 1; t < max_threads; t *= 2)
+        thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    // Prepare the random and sequential (by data offset) entry orders..
+    const auto count = static_cast<int32_t>(pkg.get_entry_count());
+
+    std::vector<int32_t> random(reads);
+    std::mt19937 rng{1337};
+    for (auto& i : random)
+        i = static_cast<int32_t>(rng() % count);
+
+    std::vector<int32_t> sequential(count);
+    std::iota(sequential.begin(), sequential.end(), 0);
+    std::sort(sequential.begin(), sequential.end(), [&pkg](const int32_t a, const int32_t b) {
+        return pkg.get_entry(a)->data_offset_ < pkg.get_entry(b)->data_offset_;
+    });
+
+    // Drops the page cache between runs when requested.. (Purging only the package files cannot drop the pages of a mapped view; runs with a package open are reported.)
+    auto dropped    = dropmethod::none;
+    auto mapped     = false;
+    const auto cool = [&](const bool open) {
+        if (!drop)
+            return;
+
+        dropped = drop_caches({pki, pkg_path});
+        if (dropped == dropmethod::files && open)
+            mapped = true;
+    };
+
+    if (!json)
+    {
+        std::cout << std::format("{:<18} {:>7} {:>10} {:>12} {:>12} {:>10} {:>10} {:>10} {:>10}", "scenario", "threads", "entries", "MB/s", "entries/s", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)") << std::endl;
+        std::cout << std::string(107, '-') << std::endl;
+    }
+
+    // Scenario: cold open
+    {
+        scenario_t res{"cold-open", 1};
+        for (uint32_t r = 0; r < runs; r++)
+        {
+            pkg.close();
+            cool(false);
+
+            const auto start = std::chrono::steady_clock::now();
+            pkg.open(pki.string());
+            const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            res.seconds_ += secs;
+            res.entries_ += pkg.get_entry_count();
+            res.latencies_.push_back(secs * 1e6);
+        }
+        print_scenario(res, json);
+    }
+
+    // Scenario: warm open
+    {
+        scenario_t res{"warm-open", 1};
+        pkg.open(pki.string());
+        for (uint32_t r = 0; r < runs; r++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            pkg.open(pki.string());
+            const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            res.seconds_ += secs;
+            res.entries_ += pkg.get_entry_count();
+            res.latencies_.push_back(secs * 1e6);
+        }
+        print_scenario(res, json);
+    }
+
+    // Scenario: random single-entry reads, cached random reads, full sequential read, extract to NUL and extract to disk..
+    for (const auto threads : thread_counts)
+    {
+        scenario_t rnd{"random-read", threads};
+        scenario_t cch{"cached-read", threads};
+        scenario_t seq{"sequential-read", threads};
+        scenario_t nul{"extract-nul", threads};
+        scenario_t dsk{"extract-disk", threads};
+        scenario_t ior{"extract-ioring", threads};
+        scenario_t mpk{"multi-pkg-read", threads};
+
+        // Open an independent package per thread..
+        std::vector<dravex::packageptr_t> pkgs;
+        for (uint32_t x = 0; x < threads; x++)
+        {
+            auto p = dravex::package::create();
+            p->set_compact_names(pkg.get_compact_names());
+            p->set_access_pattern(pkg.get_access_pattern());
+            p->set_access_span(pkg.get_access_span());
+            if (p->open(pki.string()))
+                pkgs.push_back(std::move(p));
+        }
+
+        // Closes the packages so none of their pages stay mapped, drops the page cache and reopens them..
+        const auto reopen = [&]() {
+            if (!drop)
+                return;
+
+            pkg.close();
+            for (auto& p : pkgs)
+                p->close();
+
+            cool(false);
+
+            pkg.open(pki.string());
+            for (auto& p : pkgs)
+                p->open(pki.string());
+        };
+
+        for (uint32_t r = 0; r < runs; r++)
+        {
+            reopen();
+            read_entries({handle}, random, threads, rnd);
+
+            // Prime the entry cache, then read the same entries again..
+            scenario_t prime{"prime", threads};
+            pkg.get_cache().clear();
+            read_entries({handle}, random, threads, prime, true);
+            read_entries({handle}, random, threads, cch, true);
+            reopen();
+            read_entries({handle}, sequential, threads, seq);
+            reopen();
+            extract_entries(handle, {}, threads, nul);
+            reopen();
+            extract_entries(handle, out, threads, dsk);
+            std::error_code ec{};
+            std::filesystem::remove_all(out, ec);
+            reopen();
+            extract_entries(handle, out, threads, ior, dravex::writebackend::ioring);
+            reopen();
+            if (!pkgs.empty())
+                read_entries(pkgs, random, threads, mpk);
+
+            std::filesystem::remove_all(out, ec);
+        }
+
+        print_scenario(rnd, json);
+        print_scenario(cch, json);
+        print_scenario(seq, json);
+        print_scenario(nul, json);
+        print_scenario(dsk, json);
+        print_scenario(ior, json);
+        print_scenario(mpk, json);
+
+        if (!json && dsk.calls_ != 0)
+            std::cout << std::format("{:<18} {:>7} write calls: {} with stdio, {} with ioring ({:.1f}% fewer)", "", threads, dsk.calls_, ior.calls_, 100.0 - static_cast<double>(ior.calls_) * 100.0 / static_cast<double>(dsk.calls_)) << std::endl;
+    }
+
+    // Scenario: random reads within the largest compressed entry, without and with access points
+    {
+        int32_t largest = -1;
+        for (int32_t x = 0; x < count; x++)
+        {
+            const auto entry = pkg.get_entry(x);
+            if (entry->is_compressed_ && (largest == -1 || entry->size_uncompressed_ > pkg.get_entry(largest)->size_uncompressed_))
+                largest = x;
+        }
+
+        if (largest != -1)
+        {
+            scenario_t lin{"seek-read", 1};
+            scenario_t idx{"seek-indexed", 1};
+
+            const uint64_t size = pkg.get_entry(largest)->size_uncompressed_;
+            const auto span     = std::max<uint32_t>(32 * 1024, static_cast<uint32_t>(size / 32));
+
+            std::vector<uint64_t> offsets(reads);
+            for (auto& o : offsets)
+                o = size > 4096 ? rng() % (size - 4096) : 0;
+
+            for (uint32_t r = 0; r < runs; r++)
+            {
+                for (auto* res : {&lin, &idx})
+                {
+                    auto p = dravex::package::create();
+                    p->set_compact_names(pkg.get_compact_names());
+                    p->set_access_pattern(pkg.get_access_pattern());
+                    p->set_access_span(res == &idx ? span : 0);
+                    if (!p->open(pki.string()))
+                        continue;
+
+                    // Build the access points with a full read of the entry..
+                    if (res == &idx)
+                    {
+                        dravex::entryreader reader;
+                        if (reader.open(p.get(), largest))
+                            reader.skip(size);
+                    }
+
+                    // The access points are lost when the package is closed; keep it open and mapped..
+                    cool(true);
+                    seek_entry(*p, largest, offsets, *res);
+                }
+            }
+
+            print_scenario(lin, json);
+            print_scenario(idx, json);
+        }
+    }
+
+    if (drop && !json)
+    {
+        switch (dropped)
+        {
+            case dropmethod::standby:
+                std::cout << "[bench] page cache dropped between runs via standby list purge." << std::endl;
+                break;
+            case dropmethod::files:
+                std::cout << "[bench] page cache dropped between runs for the package files only; run elevated for a full standby list purge." << std::endl;
+                if (mapped)
+                    std::cout << "[bench] the package stayed mapped during the seek scenarios, so their pages were not dropped; their cold results are likely warm." << std::endl;
+                break;
+            default:
+                std::cout << "[bench] failed to drop the page cache; cold results are likely warm." << std::endl;
+                break;
+        }
+    }
+
+    if (!json && !dravex::filewriter::is_ioring_supported())
+        std::cout << "[bench] the I/O ring is not available on this system; extract-ioring used the stdio fallback." << std::endl;
+
+    pkg.close();
+    return 0;
+}
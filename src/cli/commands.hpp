@@ -0,0 +1,126 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CLI_COMMANDS_HPP
+#define CLI_COMMANDS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "../package/package.hpp"
+
+namespace dravex::cli
+{
+    /**
+     * Returns the value of the given option from the argument list.
+     *
+     * @param {std::vector&} args - The command arguments.
+     * @param {std::string&} name - The option name. (ie. --threads)
+     * @param {std::string&} def - The default value if the option is not present.
+     * @return {std::string} The option value.
+     */
+    static std::string get_option(const std::vector<std::string>& args, const std::string& name, const std::string& def)
+    {
+        for (std::size_t x = 0; x + 1 < args.size(); x++)
+        {
+            if (args[x] == name)
+                return args[x + 1];
+        }
+        return def;
+    }
+
+    /**
+     * Returns the numeric value of the given option from the argument list.
+     *
+     * Prints an error naming the option when its value is not a number within the given range.
+     *
+     * @param {std::vector&} args - The command arguments.
+     * @param {std::string&} name - The option name. (ie. --threads)
+     * @param {uint64_t} def - The default value if the option is not present.
+     * @param {uint64_t} max - The largest value allowed.
+     * @param {uint64_t&} value - The option value.
+     * @return {bool} True on success, false otherwise.
+     */
+    static bool get_number(const std::vector<std::string>& args, const std::string& name, const uint64_t def, const uint64_t max, uint64_t& value)
+    {
+        const auto str = get_option(args, name, "");
+        if (str.empty())
+        {
+            value = def;
+            return true;
+        }
+
+        const auto end       = str.data() + str.size();
+        const auto [ptr, ec] = std::from_chars(str.data(), end, value);
+        if (ec == std::errc{} && ptr == end && value <= max)
+            return true;
+
+        std::cout << std::format("[!] Error: invalid value for option {}: {}", name, str) << std::endl;
+        return false;
+    }
+
+    /**
+     * Returns all values of the given (repeatable) option from the argument list.
+     *
+     * @param {std::vector&} args - The command arguments.
+     * @param {std::string&} name - The option name. (ie. --overlay)
+     * @return {std::vector} The option values, in order.
+     */
+    static std::vector<std::string> get_options(const std::vector<std::string>& args, const std::string& name)
+    {
+        std::vector<std::string> values;
+        for (std::size_t x = 0; x + 1 < args.size(); x++)
+        {
+            if (args[x] == name)
+                values.push_back(args[++x]);
+        }
+        return values;
+    }
+
+    /**
+     * Returns if the given flag is present within the argument list.
+     *
+     * @param {std::vector&} args - The command arguments.
+     * @param {std::string&} name - The flag name. (ie. --drop-caches)
+     * @return {bool} True if present, false otherwise.
+     */
+    static bool has_flag(const std::vector<std::string>& args, const std::string& name)
+    {
+        return std::find(args.begin(), args.end(), name) != args.end();
+    }
+
+    void print_usage(void);
+
+    int32_t cmd_bench(const dravex::packageptr_t& pkg, const std::vector<std::string>& args);
+    int32_t cmd_diff(const dravex::packageptr_t& pkg, const std::vector<std::string>& args);
+    int32_t cmd_extract(const dravex::packageptr_t& pkg, const std::vector<std::string>& args);
+
+} // namespace dravex::cli
+
+#endif // CLI_COMMANDS_HPP
@@ -0,0 +1,165 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../defines.hpp"
+#include "../logging.hpp"
+#include "../package/differ.hpp"
+#include "../package/package.hpp"
+#include "../utils.hpp"
+#include "commands.hpp"
+
+namespace
+{
+    /**
+     * Returns the JSON fields describing the given side of an entry comparison.
+     *
+     * @param {dravex::package&} pkg - The package holding the entry.
+     * @param {int32_t} index - The entry index.
+     * @param {const char*} side - The field prefix. (old or new)
+     * @return {std::string} The JSON fields.
+     */
+    std::string describe(dravex::package& pkg, const int32_t index, const char* side)
+    {
+        const auto e = pkg.get_entry(index);
+        return std::format(R"(, "{}_index": {}, "{}_offset": {}, "{}_size": {}, "{}_size_compressed": {}, "{}_checksum": "{:08X}")",
+                           side, index, side, e->data_offset_, side, e->size_uncompressed_, side, e->size_compressed_, side, e->checksum_);
+    }
+
+} // namespace
+
+/**
+ * Compares two packages and streams the differences as JSON lines.
+ *
+ * @param {dravex::packageptr_t&} pkg - The package to open the old package with.
+ * @param {std::vector&} args - The command arguments.
+ * @return {int32_t} 0 if the packages are equal, 2 if they differ, 1 on error.
+ */
+int32_t dravex::cli::cmd_diff(const dravex::packageptr_t& pkg, const std::vector<std::string>& args)
+{
+    if (args.size() < 2)
+    {
+        std::cout << "[!] Error: missing required argument: <new game.pki>" << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    uint64_t threads = 0;
+    if (!get_number(args, "--threads", std::max(1u, std::thread::hardware_concurrency()), std::numeric_limits<uint32_t>::max(), threads))
+    {
+        print_usage();
+        return 1;
+    }
+
+    // Open both packages in parallel..
+    auto other = dravex::package::create();
+    other->set_compact_names(pkg->get_compact_names());
+    other->set_access_pattern(pkg->get_access_pattern());
+    other->set_access_span(pkg->get_access_span());
+
+    pkg->open_async(args[0]);
+    other->open_async(args[1]);
+
+    if (!pkg->wait_open())
+    {
+        std::cout << std::format("[!] Error: failed to open package: {}", args[0]) << std::endl;
+        return 1;
+    }
+    if (!other->wait_open())
+    {
+        std::cout << std::format("[!] Error: failed to open package: {}", args[1]) << std::endl;
+        return 1;
+    }
+
+    // Stream the report to the given file, or stdout..
+    const auto path = get_option(args, "--out", "");
+
+    std::ofstream file;
+    if (!path.empty())
+    {
+        file.open(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cout << std::format("[!] Error: failed to open report file for writing: {}", path) << std::endl;
+            return 1;
+        }
+    }
+
+    auto& out = path.empty() ? std::cout : file;
+
+    dravex::diffoptions_t opts{};
+    opts.threads_   = static_cast<uint32_t>(threads);
+    opts.verify_    = has_flag(args, "--verify");
+    opts.unchanged_ = has_flag(args, "--all");
+
+    std::string name;
+    std::string line;
+
+    dravex::differ diff;
+    const auto ret = diff.run(pkg, other, opts, [&](const dravex::diffresult_t& r) {
+        // Describe the entry by the path of its newest version..
+        auto& p          = r.new_index_ >= 0 ? *other : *pkg;
+        const auto index = r.new_index_ >= 0 ? r.new_index_ : r.old_index_;
+
+        if (!p.get_entry_name(index, name))
+            name = "(unknown)";
+
+        line = std::format(R"({{"status": "{}", "path": "{}{}")", dravex::differ::get_status_name(r.status_), dravex::utils::json_escape(name), dravex::package::get_extension(p.get_entry(index)->file_type_));
+        if (r.old_index_ >= 0)
+            line += describe(*pkg, r.old_index_, "old");
+        if (r.new_index_ >= 0)
+            line += describe(*other, r.new_index_, "new");
+        line += std::format(R"(, "compared": "{}"}})", r.data_compared_ ? "data" : "metadata");
+
+        out << line << '\n';
+    });
+
+    const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!ret)
+    {
+        std::cout << "[!] Error: failed to compare the packages." << std::endl;
+        return 1;
+    }
+
+    const auto added     = diff.get_count(dravex::diffstatus::added);
+    const auto removed   = diff.get_count(dravex::diffstatus::removed);
+    const auto modified  = diff.get_count(dravex::diffstatus::modified);
+    const auto unchanged = diff.get_count(dravex::diffstatus::unchanged);
+
+    out << std::format(R"({{"summary": {{"added": {}, "removed": {}, "modified": {}, "unchanged": {}, "data_compared": {}, "data_bytes": {}, "seconds": {:.3f}}}}})",
+                       added, removed, modified, unchanged, diff.get_data_compared(), diff.get_data_bytes(), secs)
+        << std::endl;
+
+    if (!path.empty())
+        std::cout << std::format("[diff] {} added, {} removed, {} modified, {} unchanged ({} compared by data) in {:.2f}s.", added, removed, modified, unchanged, diff.get_data_compared(), secs) << std::endl;
+
+    other->close();
+    pkg->close();
+
+    return added + removed + modified == 0 ? 0 : 2;
+}
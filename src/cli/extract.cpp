@@ -0,0 +1,178 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../defines.hpp"
+#include "../logging.hpp"
+#include "../package/extractor.hpp"
+#include "../package/overlay.hpp"
+#include "../package/package.hpp"
+#include "commands.hpp"
+
+/**
+ * Extracts all assets of a package to disk.
+ *
+ * @param {dravex::packageptr_t&} pkg - The package to extract with.
+ * @param {std::vector&} args - The command arguments.
+ * @return {int32_t} 0 on success, 1 otherwise.
+ */
+int32_t dravex::cli::cmd_extract(const dravex::packageptr_t& pkg, const std::vector<std::string>& args)
+{
+    const auto out = get_option(args, "--out", "");
+    if (out.empty())
+    {
+        std::cout << "[!] Error: missing required option: --out <dir>" << std::endl;
+        return 1;
+    }
+
+    uint64_t threads = 0;
+    uint64_t stream  = 0;
+    if (!get_number(args, "--threads", std::max(1u, std::thread::hardware_concurrency()), std::numeric_limits<uint32_t>::max(), threads) ||
+        !get_number(args, "--stream", 0, std::numeric_limits<uint32_t>::max(), stream))
+    {
+        print_usage();
+        return 1;
+    }
+
+    if (!pkg->open(args[0]))
+    {
+        std::cout << std::format("[!] Error: failed to open package: {}", args[0]) << std::endl;
+        return 1;
+    }
+
+    // Stack the overlay packages over the base package, in the given order..
+    const auto overlays = get_options(args, "--overlay");
+
+    dravex::overlayptr_t view = nullptr;
+    if (!overlays.empty())
+    {
+        view = dravex::overlay::create();
+        view->add_layer(pkg);
+
+        for (const auto& path : overlays)
+        {
+            auto layer = dravex::package::create();
+            layer->set_compact_names(pkg->get_compact_names());
+            layer->set_access_pattern(pkg->get_access_pattern());
+            layer->set_access_span(pkg->get_access_span());
+
+            if (!layer->open(path))
+            {
+                std::cout << std::format("[!] Error: failed to open overlay package: {}", path) << std::endl;
+                return 1;
+            }
+
+            view->add_layer(layer);
+        }
+
+        if (!view->build())
+        {
+            std::cout << "[!] Error: failed to build the overlay." << std::endl;
+            return 1;
+        }
+
+        std::cout << std::format("[extract] overlay of {} packages: {} entries, {} replaced.", view->get_layer_count(), view->get_entry_count(), view->get_replaced_count()) << std::endl;
+    }
+
+    dravex::extractoptions_t opts{};
+    opts.root_        = out;
+    opts.threads_     = static_cast<uint32_t>(threads);
+    opts.links_       = !has_flag(args, "--no-links");
+    opts.incremental_ = has_flag(args, "--incremental");
+    opts.backend_     = dravex::writebackend::stdio;
+    opts.zerocopy_    = !has_flag(args, "--no-zerocopy");
+    opts.stream_size_ = stream * 1024 * 1024;
+
+    const auto io = get_option(args, "--io", "stdio");
+    if (io == "ioring")
+        opts.backend_ = dravex::writebackend::ioring;
+    else if (io == "direct")
+        opts.backend_ = dravex::writebackend::direct;
+
+    if (opts.backend_ == dravex::writebackend::ioring && !dravex::filewriter::is_ioring_supported())
+        std::cout << "[!] Warning: the I/O ring is not available on this system; using stdio instead." << std::endl;
+
+    // Stream the extraction manifest as JSON lines and/or in the binary form..
+    opts.manifest_json_   = get_option(args, "--manifest", "");
+    opts.manifest_binary_ = get_option(args, "--manifest-bin", "");
+
+    // Deduplicate the content into a content store; defaults to a store within the output directory..
+    if (has_flag(args, "--dedup") || !get_option(args, "--store", "").empty())
+        opts.store_ = get_option(args, "--store", (std::filesystem::path{out} / ".store").string());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    dravex::extractor ext;
+    if (!(view != nullptr ? ext.start(view, opts) : ext.start(pkg, opts)))
+    {
+        std::cout << "[!] Error: failed to start extraction." << std::endl;
+        return 1;
+    }
+
+    ext.wait();
+
+    const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& i : ext.get_failed_index())
+        std::cout << std::format("[!] Error: failed to extract asset at index: {}", i) << std::endl;
+    for (const auto& p : ext.get_failed_paths())
+        std::cout << std::format("[!] Error: failed to extract asset to path: {}", p.string()) << std::endl;
+
+    std::cout << std::format("[extract] extracted {} assets ({} bytes) in {:.2f}s.", ext.get_completed(), ext.get_bytes_written(), secs) << std::endl;
+
+    std::cout << std::format("[extract] io: {}, {} write calls.", dravex::filewriter::get_backend_name(opts.backend_ == dravex::writebackend::ioring && !dravex::filewriter::is_ioring_supported() ? dravex::writebackend::stdio : opts.backend_), ext.get_write_calls()) << std::endl;
+
+    if (opts.zerocopy_)
+        std::cout << std::format("[extract] zero-copy: {} bytes of uncompressed assets copied from the mapped package, {} bytes block cloned.", ext.get_zerocopy_bytes(), ext.get_cloned_bytes()) << std::endl;
+
+    if (!opts.manifest_json_.empty() || !opts.manifest_binary_.empty())
+        std::cout << std::format("[extract] manifest: {} records written.", ext.get_manifest_count()) << std::endl;
+
+    if (opts.stream_size_ != 0)
+        std::cout << std::format("[extract] streamed: {} assets of at least {} MB inflated a chunk at a time.", ext.get_streamed(), opts.stream_size_ / (1024 * 1024)) << std::endl;
+
+    if (opts.incremental_)
+        std::cout << std::format("[extract] incremental: {} unchanged assets skipped, {} assets extracted.", ext.get_skipped(), ext.get_completed() - ext.get_skipped()) << std::endl;
+
+    // Report the deduplication results..
+    if (!opts.store_.empty())
+    {
+        const auto& store = ext.get_store();
+
+        std::cout << std::format("[extract] dedup: {} unique objects stored ({} bytes).", store.get_count(dravex::storeresult::stored), store.get_bytes(dravex::storeresult::stored)) << std::endl;
+        std::cout << std::format("[extract] dedup: {} objects reused from the store ({} bytes).", store.get_count(dravex::storeresult::reused), store.get_bytes(dravex::storeresult::reused)) << std::endl;
+        std::cout << std::format("[extract] dedup: {} duplicates ({} bytes not written).", store.get_count(dravex::storeresult::duplicate), store.get_bytes(dravex::storeresult::duplicate)) << std::endl;
+
+        if (ext.get_link_failures() != 0)
+            std::cout << std::format("[!] Warning: {} paths could not be linked to the store and were written instead.", ext.get_link_failures()) << std::endl;
+
+        std::cout << std::format("[extract] dedup: manifest saved to: {}", ext.get_digests_path().string()) << std::endl;
+    }
+
+    pkg->close();
+
+    return ext.get_failed_index().empty() && ext.get_failed_paths().empty() ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../defines.hpp"
+#include "../logging.hpp"
+#include "../package/package.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
+#include "commands.hpp"
+
+/**
+ * Prints the command line usage information.
+ */
+void dravex::cli::print_usage(void)
+{
+    std::cout << "usage: dravex-cli <command> <game.pki> [options]" << std::endl
+              << std::endl
+              << "commands:" << std::endl
+              << "  extract <game.pki> --out <dir> [--threads <n>] [--overlay <game.pki>]... [--dedup] [--store <dir>] [--no-links] [--incremental] [--manifest <file>] [--manifest-bin <file>] [--io <stdio|ioring|direct>] [--no-zerocopy] [--stream <mb>]" << std::endl
+              << "      Extracts all assets of the package to the given directory." << std::endl
+              << "      Each --overlay package is stacked over the previous ones, replacing their entries with the same path." << std::endl
+              << "      --dedup stores each unique content once in a content store (<out>/.store, or --store <dir>) and hard links the paths to it." << std::endl
+              << "      --no-links only maps the paths to the stored content within <out>/dedup.sha256." << std::endl
+              << "      --incremental skips the assets whose output matches the previous extraction into <out>." << std::endl
+              << "      --manifest and --manifest-bin stream a record of each extracted asset as JSON lines or in a compact binary form." << std::endl
+              << "      --io ioring batches the file writes into a Windows I/O ring, falling back to stdio when it is not available." << std::endl
+              << "      --io direct writes unbuffered and write-through, keeping the output out of the system cache." << std::endl
+              << "      --stream inflates and writes the assets of at least <mb> megabytes a chunk at a time, bounding the memory used." << std::endl
+              << "      --no-zerocopy reads uncompressed assets into a buffer instead of copying them from the mapped package." << std::endl
+              << std::endl
+              << "  diff <old game.pki> <new game.pki> [--threads <n>] [--out <file>] [--verify] [--all]" << std::endl
+              << "      Compares two packages, streaming the added, removed and modified entries as JSON lines." << std::endl
+              << std::endl
+              << "  bench <game.pki> [--threads <n>] [--runs <n>] [--reads <n>] [--out <dir>] [--drop-caches] [--json]" << std::endl
+              << "      Measures open, read and extraction throughput of the package on this machine." << std::endl
+              << std::endl
+              << "options:" << std::endl
+              << "  --stats" << std::endl
+              << "      Prints the package instrumentation counters and stage timings once the command finishes." << std::endl
+              << "  --log <file>" << std::endl
+              << "      Writes the log to the given file, rotating it every 16MB and keeping the last 4 files." << std::endl
+              << "  --trace <file>" << std::endl
+              << "      Records a timeline of the command and writes it to the given file as a Chrome trace. (chrome://tracing, ui.perfetto.dev)" << std::endl
+              << "  --compact-names" << std::endl
+              << "      Stores the entry names front-coded, using less memory for the package index." << std::endl
+              << "  --access <normal|sequential|random>" << std::endl
+              << "      Hints how the package data is read. sequential reads ahead and drops the pages behind a single pass;" << std::endl
+              << "      random populates the package mapping up front for repeated random reads." << std::endl
+              << "  --access-points <kb>" << std::endl
+              << "      Records access points every <kb> of output while large compressed entries are read in full, so later" << std::endl
+              << "      seeks into them resume close to the offset instead of inflating from the start. (32KB window per point.)" << std::endl;
+}
+
+/**
+ * Prints the aggregated instrumentation counters and stage timings.
+ *
+ * @param {dravex::package&} pkg - The package used by the command.
+ */
+void print_stats(dravex::package& pkg)
+{
+    const auto snap = dravex::stats::instance().snapshot();
+
+    std::cout << std::endl
+              << "[stats] counters:" << std::endl;
+    for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::counter::count); x++)
+        std::cout << std::format("  {:<16} {:>16}", dravex::stats::get_counter_name(static_cast<dravex::counter>(x)), snap.counters_[x]) << std::endl;
+
+    std::cout << "[stats] stages:" << std::endl;
+    for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::stage::count); x++)
+    {
+        const auto calls = snap.stage_calls_[x];
+        const auto ms    = static_cast<double>(snap.stage_ns_[x]) / 1e6;
+        const auto avg   = calls > 0 ? static_cast<double>(snap.stage_ns_[x]) / 1e3 / static_cast<double>(calls) : 0.0;
+
+        std::cout << std::format("  {:<16} calls: {:>10} total: {:>12.3f} ms avg: {:>10.3f} us", dravex::stats::get_stage_name(static_cast<dravex::stage>(x)), calls, ms, avg) << std::endl;
+    }
+
+    const auto cache = pkg.get_cache().get_stats();
+    std::cout << "[stats] entry cache:" << std::endl
+              << std::format("  entries: {} bytes: {} budget: {} hits: {} misses: {} evictions: {}", cache.entries_, cache.bytes_, cache.budget_, cache.hits_, cache.misses_, cache.evictions_) << std::endl;
+}
+
+/**
+ * Application entry point.
+ *
+ * @param {int32_t} argc - The argument count passed to the application.
+ * @param {char*[]} argv - The argument array passed to the application.
+ * @return {int32_t} 0 on success, 1 otherwise.
+ */
+int32_t __cdecl main(int32_t argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        dravex::cli::print_usage();
+        return 1;
+    }
+
+    const std::string cmd = argv[1];
+    const std::vector<std::string> args(argv + 2, argv + argc);
+
+    const auto stats = dravex::cli::has_flag(args, "--stats");
+    dravex::stats::instance().set_enabled(stats);
+
+    const auto log = dravex::cli::get_option(args, "--log", "");
+    if (!log.empty() && !dravex::logging::instance().open_file(log, 16 * 1024 * 1024, 4))
+        std::cout << std::format("[log] failed to open log file: {}", log) << std::endl;
+
+    const auto trace = dravex::cli::get_option(args, "--trace", "");
+    dravex::tracing::instance().set_enabled(!trace.empty());
+    dravex::tracing::instance().set_thread_name("main");
+
+    auto pkg = dravex::package::create();
+    pkg->set_compact_names(dravex::cli::has_flag(args, "--compact-names"));
+
+    const auto access = dravex::cli::get_option(args, "--access", "normal");
+    if (access == "sequential")
+        pkg->set_access_pattern(dravex::accesspattern::sequential);
+    else if (access == "random")
+        pkg->set_access_pattern(dravex::accesspattern::random);
+
+    uint64_t span = 0;
+    if (!dravex::cli::get_number(args, "--access-points", 0, std::numeric_limits<uint32_t>::max() / 1024, span))
+    {
+        dravex::cli::print_usage();
+        return 1;
+    }
+
+    pkg->set_access_span(static_cast<uint32_t>(span * 1024));
+
+    auto ret = 1;
+    if (cmd == "bench")
+        ret = dravex::cli::cmd_bench(pkg, args);
+    else if (cmd == "diff")
+        ret = dravex::cli::cmd_diff(pkg, args);
+    else if (cmd == "extract")
+        ret = dravex::cli::cmd_extract(pkg, args);
+    else
+    {
+        dravex::cli::print_usage();
+        return 1;
+    }
+
+    if (stats)
+        print_stats(*pkg);
+
+    if (!trace.empty())
+    {
+        if (dravex::tracing::instance().write(trace))
+            std::cout << std::format("[trace] wrote timeline to: {}", trace) << std::endl;
+        else
+            std::cout << std::format("[trace] failed to write timeline to: {}", trace) << std::endl;
+    }
+
+    dravex::logging::instance().close_file();
+
+    return ret;
+}
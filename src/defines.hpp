@@ -73,6 +73,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#pragma comment(lib, "Bcrypt.lib")
 #pragma comment(lib, "Psapi.lib")
 #pragma comment(lib, "Version.lib")
 #pragma comment(lib, "WinMM.lib")
@@ -80,9 +81,16 @@
 #include <Windows.h>
 #include <windowsx.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bcrypt.h>
 #include <cctype>
+#include <charconv>
+#include <chrono>
 #include <codecvt>
+#include <condition_variable>
 #include <csignal>
+#include <deque>
 #include <eh.h>
 #include <filesystem>
 #include <format>
@@ -90,6 +98,8 @@
 #include <functional>
 #include <future>
 #include <iostream>
+#include <latch>
+#include <list>
 #include <locale>
 #include <map>
 #include <mutex>
@@ -103,6 +113,7 @@
 #include <sstream>
 #include <string>
 #include <time.h>
+#include <thread>
 #include <TlHelp32.h>
 #include <unordered_map>
 #include <utility>
@@ -32,13 +32,34 @@
  * Constructor and Destructor
  */
 dravex::logging::logging(void)
-    : autoscroll_{true}
+    : head_{0}
+    , dropped_{0}
+    , tail_{0}
+    , queue_{std::make_unique<details::logslot_t[]>(queue_size)}
+    , autoscroll_{true}
     , autoscroll_new_entries_{true}
     , scroll_{false}
     , clear_{false}
-{}
+    , epoch_{std::chrono::steady_clock::now()}
+    , file_enabled_{false}
+    , file_{nullptr}
+    , file_size_{0}
+    , file_max_size_{0}
+    , file_max_count_{0}
+    , file_stop_{false}
+{
+    // Prepare the queue slot sequences..
+    for (uint64_t x = 0; x < queue_size; x++)
+        this->queue_[x].sequence_.store(x, std::memory_order_relaxed);
+}
 dravex::logging::~logging(void)
-{}
+{
+    // Stop the file sink, writing any pending messages..
+    this->close_file();
+
+    // Release any pending message arguments..
+    this->flush();
+}
 
 /**
  * Returns the singleton instance of this class.
@@ -51,37 +72,303 @@ dravex::logging& dravex::logging::instance(void)
     return log;
 }
 
+/**
+ * Returns the display name of the given log level.
+ *
+ * @param {dravex::loglevel} level - The log level.
+ * @return {const char*} The log level name.
+ */
+const char* dravex::logging::get_level_name(const dravex::loglevel level)
+{
+    switch (level)
+    {
+        case dravex::loglevel::none:
+            return "none";
+        case dravex::loglevel::critical:
+            return "critical";
+        case dravex::loglevel::error:
+            return "error";
+        case dravex::loglevel::warn:
+            return "warn";
+        case dravex::loglevel::info:
+            return "info";
+        case dravex::loglevel::debug:
+            return "debug";
+    }
+    return "unknown";
+}
+
 /**
  * Clears the current log.
  */
 void dravex::logging::clear(void)
 {
+    std::lock_guard<std::mutex> lock{this->mutex_};
     this->log_.clear();
 }
 
 /**
- * Logs the given message.
+ * Reserves the next free slot of the message queue.
  *
- * @param {dravex::loglevel&} level - The level of the message being logged.
- * @param {std::string&} message - The message to log.
+ * @param {uint64_t&} sequence - The sequence number of the reserved slot.
+ * @return {details::logslot_t*} The reserved slot on success, nullptr if the queue is full.
  */
-void dravex::logging::log(const dravex::loglevel level, const std::string& message)
+dravex::details::logslot_t* dravex::logging::acquire(uint64_t& sequence)
+{
+    auto pos = this->head_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        auto slot       = &this->queue_[pos & (queue_size - 1)];
+        const auto seq  = slot->sequence_.load(std::memory_order_acquire);
+        const auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+
+        // The slot is free; attempt to claim it..
+        if (diff == 0)
+        {
+            if (this->head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                sequence = pos;
+                return slot;
+            }
+        }
+
+        // The slot has not been drained yet; the queue is full..
+        else if (diff < 0)
+            return nullptr;
+
+        // Another thread claimed the slot; reload the head..
+        else
+            pos = this->head_.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Marks a reserved slot as ready to be drained.
+ *
+ * @param {details::logslot_t*} slot - The slot to publish.
+ * @param {uint64_t} sequence - The sequence number of the slot.
+ */
+void dravex::logging::publish(details::logslot_t* slot, const uint64_t sequence)
+{
+    slot->sequence_.store(sequence + 1, std::memory_order_release);
+}
+
+/**
+ * Drains the message queue, formatting the pending messages into the log.
+ *
+ * Called once per frame by the main loop; the log is capped to the last 'history_size' messages.
+ */
+void dravex::logging::flush(void)
 {
     std::lock_guard<std::mutex> lock{this->mutex_};
 
-    // Add the message to the log..
-    this->log_.push_back(std::make_tuple(level, message));
+    auto count = 0;
+    while (true)
+    {
+        auto& slot = this->queue_[this->tail_ & (queue_size - 1)];
+        if (slot.sequence_.load(std::memory_order_acquire) != this->tail_ + 1)
+            break;
+
+        // Format the message and release its arguments..
+        std::string message;
+        slot.render_(message, slot.format_, slot.args_);
+        slot.destroy_(slot.args_);
+
+        const auto level = slot.level_;
+        const auto time  = slot.time_;
+        slot.sequence_.store(this->tail_ + queue_size, std::memory_order_release);
+        this->tail_++;
+
+        // Queue the message for the file sink..
+        if (this->file_enabled_)
+            std::format_to(std::back_inserter(this->file_pending_), "[{:>14.6f}] [{:<8}] {}\n", static_cast<double>(time) / 1e9, get_level_name(level), message);
+
+        this->log_.emplace_back(level, std::move(message));
+        count++;
+    }
+
+    // Note any messages that were lost due to the queue being full..
+    const auto dropped = this->dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0)
+    {
+        this->log_.emplace_back(dravex::loglevel::warn, std::format("[log] dropped {} message(s); the log queue was full..", dropped));
+        count++;
+    }
+
+    // Trim the log to its size limit..
+    while (this->log_.size() > history_size)
+        this->log_.pop_front();
 
-    // Mark the log to scroll due to a new entry..
-    if (this->autoscroll_new_entries_)
+    // Mark the log to scroll due to new entries..
+    if (count > 0 && this->autoscroll_new_entries_)
         this->scroll_ = true;
 }
 
+/**
+ * Opens a log file that all messages are written to by a background thread.
+ *
+ * Messages are written in batches each time the writer wakes. Once the file exceeds the given size it is
+ * rotated; the current file is renamed to 'path.1', the previous 'path.1' to 'path.2', and so on up to the
+ * given count.
+ *
+ * @param {std::filesystem::path&} path - The path to the log file.
+ * @param {uint64_t} max_size - The size, in bytes, a log file may reach before it is rotated.
+ * @param {uint32_t} max_count - The number of rotated log files to keep.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::logging::open_file(const std::filesystem::path& path, const uint64_t max_size, const uint32_t max_count)
+{
+    this->close_file();
+
+    if (::fopen_s(&this->file_, path.string().c_str(), "wb") != ERROR_SUCCESS || this->file_ == nullptr)
+    {
+        this->file_ = nullptr;
+        return false;
+    }
+
+    this->file_path_      = path;
+    this->file_size_      = 0;
+    this->file_max_size_  = max_size;
+    this->file_max_count_ = max_count;
+    this->file_stop_      = false;
+
+    {
+        std::lock_guard<std::mutex> lock{this->mutex_};
+        this->file_enabled_ = true;
+    }
+
+    this->file_thread_ = std::thread(&dravex::logging::file_worker, this);
+    return true;
+}
+
+/**
+ * Stops the background log file writer, writing any pending messages before closing the file.
+ */
+void dravex::logging::close_file(void)
+{
+    if (!this->file_thread_.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock{this->file_mutex_};
+        this->file_stop_ = true;
+    }
+
+    this->file_cv_.notify_one();
+    this->file_thread_.join();
+
+    {
+        std::lock_guard<std::mutex> lock{this->mutex_};
+        this->file_enabled_ = false;
+        this->file_pending_.clear();
+    }
+
+    if (this->file_ != nullptr)
+    {
+        ::fclose(this->file_);
+        this->file_ = nullptr;
+    }
+}
+
+/**
+ * Background log file writer thread.
+ */
+void dravex::logging::file_worker(void)
+{
+    std::string batch;
+
+    while (true)
+    {
+        bool stop = false;
+        {
+            std::unique_lock<std::mutex> lock{this->file_mutex_};
+            this->file_cv_.wait_for(lock, std::chrono::milliseconds(50), [this] { return this->file_stop_; });
+            stop = this->file_stop_;
+        }
+
+        // Drain the queue and take the pending file output..
+        this->flush();
+        {
+            std::lock_guard<std::mutex> lock{this->mutex_};
+            batch.swap(this->file_pending_);
+        }
+
+        if (!batch.empty())
+        {
+            this->file_write(batch);
+            batch.clear();
+        }
+
+        if (stop)
+            break;
+    }
+}
+
+/**
+ * Writes a batch of formatted messages to the log file, rotating it if needed.
+ *
+ * @param {std::string&} batch - The formatted messages to write.
+ */
+void dravex::logging::file_write(const std::string& batch)
+{
+    if (this->file_max_size_ > 0 && this->file_size_ > 0 && this->file_size_ + batch.size() > this->file_max_size_)
+        this->file_rotate();
+
+    if (this->file_ == nullptr)
+        return;
+
+    this->file_size_ += ::fwrite(batch.data(), 1, batch.size(), this->file_);
+    ::fflush(this->file_);
+}
+
+/**
+ * Rotates the log file, shifting the older log files up by one.
+ */
+void dravex::logging::file_rotate(void)
+{
+    ::fclose(this->file_);
+    this->file_ = nullptr;
+
+    const auto name = [this](const uint32_t index) -> std::filesystem::path {
+        return std::format("{}.{}", this->file_path_.string(), index);
+    };
+
+    std::error_code ec;
+    if (this->file_max_count_ > 0)
+    {
+        std::filesystem::remove(name(this->file_max_count_), ec);
+        for (auto x = this->file_max_count_ - 1; x > 0; x--)
+            std::filesystem::rename(name(x), name(x + 1), ec);
+        std::filesystem::rename(this->file_path_, name(1), ec);
+    }
+
+    if (::fopen_s(&this->file_, this->file_path_.string().c_str(), "wb") != ERROR_SUCCESS)
+        this->file_ = nullptr;
+
+    this->file_size_ = 0;
+}
+
+/**
+ * Logs the given message.
+ *
+ * @param {dravex::loglevel&} level - The level of the message being logged.
+ * @param {std::string&} message - The message to log.
+ */
+void dravex::logging::log(const dravex::loglevel level, const std::string& message)
+{
+    this->push(level, "{}", message);
+}
+
 /**
  * Renders the log via ImGui.
  */
 void dravex::logging::render(void)
 {
+    this->flush();
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
     if (ImGui::BeginTable("##dravex_log_table", 2, ImGuiTableFlags_BordersH | ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_BordersOuterH | ImGuiTableFlags_BordersOuterV | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_ContextMenuInBody | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoSavedSettings, ImVec2(0.0f, 0.0f), 0.0f))
     {
         ImGui::TableSetupColumn("##icon", ImGuiTableColumnFlags_WidthFixed);
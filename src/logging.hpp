@@ -33,6 +33,29 @@
 
 #include "defines.hpp"
 
+/**
+ * The most verbose log level compiled into the binary. (See: dravex::loglevel)
+ *
+ * Calls made through DRAVEX_LOG above this level are removed at compile time, including the
+ * evaluation of their arguments. Set by the build via the DRAVEX_LOG_LEVEL CMake cache value.
+ */
+#ifndef DRAVEX_LOG_LEVEL
+#define DRAVEX_LOG_LEVEL 5
+#endif
+
+/**
+ * Logs a message if its level is compiled into the binary.
+ *
+ * @param {dravex::loglevel} level - The level of the message being logged.
+ * @param {...} - The message, or the message format string and its arguments.
+ */
+#define DRAVEX_LOG(level, ...)                                                  \
+    do                                                                          \
+    {                                                                           \
+        if constexpr (static_cast<int32_t>(level) <= DRAVEX_LOG_LEVEL)          \
+            dravex::logging::instance().log(level, __VA_ARGS__);                \
+    } while (0)
+
 namespace dravex
 {
     enum class loglevel : int32_t
@@ -45,6 +68,35 @@ namespace dravex
         debug    = 5,
     };
 
+    namespace details
+    {
+        /**
+         * Storage type used to hold a deferred log argument.
+         *
+         * Character pointers and string views are copied into a string so the message does not
+         * depend on the lifetime of the callers buffer by the time it is formatted.
+         */
+        template<typename T>
+        using logarg_t = std::conditional_t<std::is_convertible_v<std::decay_t<T>, std::string_view>, std::string, std::decay_t<T>>;
+
+        /**
+         * Structure definition for a single queued (unformatted) log message.
+         */
+        struct logslot_t
+        {
+            static constexpr std::size_t args_size = 96;
+
+            std::atomic<uint64_t> sequence_;
+            dravex::loglevel level_;
+            int64_t time_;
+            std::string_view format_;
+            void (*render_)(std::string& out, std::string_view fmt, void* args);
+            void (*destroy_)(void* args);
+            alignas(std::max_align_t) uint8_t args_[args_size];
+        };
+
+    } // namespace details
+
     class logging final
     {
         logging(logging const&)            = delete;
@@ -55,19 +107,111 @@ namespace dravex
         logging(void);
         ~logging(void);
 
+    public:
+        static constexpr uint64_t queue_size      = 2048;
+        static constexpr std::size_t history_size = 10000;
+
+    private:
+        alignas(64) std::atomic<uint64_t> head_;
+        alignas(64) std::atomic<uint64_t> dropped_;
+        alignas(64) uint64_t tail_;
+        std::unique_ptr<details::logslot_t[]> queue_;
+
         mutable std::mutex mutex_;
-        std::vector<std::tuple<dravex::loglevel, std::string>> log_;
+        std::deque<std::tuple<dravex::loglevel, std::string>> log_;
         bool autoscroll_;
         bool autoscroll_new_entries_;
         bool scroll_;
         bool clear_;
 
+        std::chrono::steady_clock::time_point epoch_;
+        bool file_enabled_;
+        std::string file_pending_;
+        FILE* file_;
+        std::filesystem::path file_path_;
+        uint64_t file_size_;
+        uint64_t file_max_size_;
+        uint32_t file_max_count_;
+        std::thread file_thread_;
+        std::mutex file_mutex_;
+        std::condition_variable file_cv_;
+        bool file_stop_;
+
+        void file_worker(void);
+        void file_write(const std::string& batch);
+        void file_rotate(void);
+
+        details::logslot_t* acquire(uint64_t& sequence);
+        void publish(details::logslot_t* slot, const uint64_t sequence);
+
+        /**
+         * Queues a message to be formatted when the log is next flushed.
+         *
+         * @param {dravex::loglevel} level - The level of the message being logged.
+         * @param {std::string_view} fmt - The message format string. (Must outlive the queued message.)
+         * @param {Args&&...} args - The message format arguments.
+         */
+        template<typename... Args>
+        void push(const dravex::loglevel level, const std::string_view fmt, Args&&... args)
+        {
+            using tuple_t = std::tuple<details::logarg_t<Args>...>;
+
+            uint64_t sequence = 0;
+            auto slot         = this->acquire(sequence);
+            if (slot == nullptr)
+            {
+                this->dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            slot->level_   = level;
+            slot->time_    = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->epoch_).count();
+            slot->format_  = fmt;
+            slot->render_  = [](std::string& out, std::string_view f, void* data) {
+                std::apply([&](auto&... a) { out = std::vformat(f, std::make_format_args(a...)); }, *static_cast<tuple_t*>(data));
+            };
+            slot->destroy_ = [](void* data) {
+                static_cast<tuple_t*>(data)->~tuple_t();
+            };
+            new (slot->args_) tuple_t(std::forward<Args>(args)...);
+
+            this->publish(slot, sequence);
+        }
+
     public:
         static logging& instance(void);
 
+        static const char* get_level_name(const dravex::loglevel level);
+
         void clear(void);
+        void flush(void);
+
+        bool open_file(const std::filesystem::path& path, const uint64_t max_size, const uint32_t max_count);
+        void close_file(void);
         void log(const dravex::loglevel level, const std::string& message);
 
+        /**
+         * Logs the given message, deferring its formatting until the log is next flushed.
+         *
+         * The arguments are copied into a fixed size queue slot; the calling thread never takes a lock or
+         * formats the message. Arguments too large to fit within a slot are formatted immediately instead.
+         *
+         * @param {dravex::loglevel} level - The level of the message being logged.
+         * @param {std::format_string} fmt - The message format string.
+         * @param {Arg0&&} arg0 - The first message format argument.
+         * @param {Args&&...} args - The remaining message format arguments.
+         */
+        template<typename Arg0, typename... Args>
+        void log(const dravex::loglevel level, std::format_string<Arg0, Args...> fmt, Arg0&& arg0, Args&&... args)
+        {
+            using tuple_t = std::tuple<details::logarg_t<Arg0>, details::logarg_t<Args>...>;
+
+            if constexpr (sizeof(tuple_t) > details::logslot_t::args_size || alignof(tuple_t) > alignof(std::max_align_t))
+                this->push(level, "{}", std::format(fmt, std::forward<Arg0>(arg0), std::forward<Args>(args)...));
+            else
+                this->push(level, fmt.get(), std::forward<Arg0>(arg0), std::forward<Args>(args)...);
+        }
+
         void render(void);
     };
 
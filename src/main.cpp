@@ -30,9 +30,14 @@
 #include "imgui_fontawesome.hpp"
 #include "imgui_fontawesome_brands.hpp"
 #include "logging.hpp"
+#include "package/extractor.hpp"
 #include "package/package.hpp"
+#include "package/prefetcher.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
 #include "window.hpp"
 
+#include "assets/loader.hpp"
 #include "assets/asset_font.hpp"
 #include "assets/asset_ogg.hpp"
 #include "assets/asset_splash.hpp"
@@ -44,6 +49,7 @@
  * Globals
  */
 std::shared_ptr<dravex::window> g_window;
+dravex::packageptr_t g_package;
 std::shared_ptr<dravex::assets::asset> g_asset;
 bool g_has_pending_asset       = false;
 int32_t g_selected_asset_index = -1;
@@ -52,10 +58,9 @@ int32_t g_pending_asset_index  = -1;
 /**
  * Globals (Extraction Overlay)
  */
-int32_t g_extract_modal_index              = 0;
-std::filesystem::path g_extract_modal_path = "";
-bool g_extract_modal_show                  = false;
-std::thread g_extract_modal_thread;
+dravex::extractor g_extractor;
+bool g_extract_modal_show  = false;
+bool g_extract_incremental = false;
 
 /**
  * Resets the various asset variables.
@@ -66,6 +71,8 @@ void reset_asset_variables(void)
     g_has_pending_asset    = false;
     g_pending_asset_index  = -1;
 
+    dravex::assets::loader::instance().cancel();
+
     if (g_asset)
     {
         g_asset->release();
@@ -79,17 +86,22 @@ void reset_asset_variables(void)
 void extract_asset(void)
 {
     // Obtain the selected asset entry information..
-    const auto& entry = dravex::package::instance().get_entry(g_selected_asset_index);
+    const auto& entry = g_package->get_entry(g_selected_asset_index);
     if (entry == nullptr)
         return;
 
-    const auto& data = dravex::package::instance().get_entry_data(g_selected_asset_index);
-    const auto& name = dravex::package::instance().get_string(entry->string_offset_);
-    auto ext         = dravex::package::instance().get_extension(entry->file_type_);
+    const auto data = g_package->get_entry_buffer(g_selected_asset_index);
+    if (data == nullptr)
+        return;
+
+    std::string name;
+    if (!g_package->get_entry_name(g_selected_asset_index, name))
+        name = "(unknown)";
+    auto ext = g_package->get_extension(entry->file_type_);
 
     // Prepare the default file name..
     char file_name[MAX_PATH]{};
-    ::sprintf_s(file_name, MAX_PATH, "%s%s", name == nullptr ? "(unknown)" : name, (ext == nullptr || ::strlen(ext) == 0) ? ".raw" : ext);
+    ::sprintf_s(file_name, MAX_PATH, "%s%s", name.c_str(), (ext == nullptr || ::strlen(ext) == 0) ? ".raw" : ext);
 
     // Display the save as dialog..
     OPENFILENAMEA ofn{};
@@ -112,14 +124,47 @@ void extract_asset(void)
         FILE* f = nullptr;
         if (::fopen_s(&f, file_name, "wb") == ERROR_SUCCESS)
         {
-            ::fwrite(data.data(), data.size(), 1, f);
+            ::fwrite(data->data(), data->size(), 1, f);
             ::fclose(f);
         }
         else
-            dravex::logging::instance().log(dravex::loglevel::error, std::format("[extract] failed to extract asset to path: {}", file_name));
+            DRAVEX_LOG(dravex::loglevel::error, "[extract] failed to extract asset to path: {}", file_name);
     }
 }
 
+/**
+ * Writes the recorded trace events to disk.
+ */
+void export_trace(void)
+{
+    // Prepare the default file name..
+    char file_name[MAX_PATH]{};
+    ::strcpy_s(file_name, MAX_PATH, "dravex_trace.json");
+
+    // Display the save as dialog..
+    OPENFILENAMEA ofn{};
+    ofn.lStructSize     = sizeof(OPENFILENAMEA);
+    ofn.hwndOwner       = g_window->get_hwnd();
+    ofn.hInstance       = ::GetModuleHandleA(nullptr);
+    ofn.lpstrFilter     = "Chrome Trace (*.json)\0*.json\0";
+    ofn.nFilterIndex    = 1;
+    ofn.lpstrFile       = file_name;
+    ofn.nMaxFile        = MAX_PATH;
+    ofn.lpstrFileTitle  = nullptr;
+    ofn.nMaxFileTitle   = 0;
+    ofn.lpstrInitialDir = nullptr;
+    ofn.Flags           = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT;
+    ofn.lpstrDefExt     = "json";
+
+    if (!::GetSaveFileNameA(&ofn))
+        return;
+
+    if (dravex::tracing::instance().write(file_name))
+        DRAVEX_LOG(dravex::loglevel::info, "[trace] wrote trace to: {}", file_name);
+    else
+        DRAVEX_LOG(dravex::loglevel::error, "[trace] failed to write trace to: {}", file_name);
+}
+
 /**
  * Extracts all assets to disk.
  */
@@ -142,82 +187,15 @@ void extract_assets(void)
     ::SHGetPathFromIDListA(ret, file_path);
     ::CoTaskMemFree(ret);
 
-    // Prepare the root path..
-    std::error_code ec{};
-    std::filesystem::path root = file_path;
+    // Prepare the extraction options..
+    dravex::extractoptions_t opts{};
+    opts.root_        = file_path;
+    opts.threads_     = std::max(1u, std::thread::hardware_concurrency());
+    opts.incremental_ = g_extract_incremental;
 
-    // Ensure the path exists..
-    if (!std::filesystem::exists(root, ec))
-        std::filesystem::create_directories(root, ec);
-
-    // Mark the extraction overlay to display..
-    g_extract_modal_index = 0;
-    g_extract_modal_path  = root;
-    g_extract_modal_show  = true;
-
-    // Start the extract thread..
-    g_extract_modal_thread = std::thread([]() {
-        std::vector<int32_t> failed_index;
-        std::vector<std::filesystem::path> failed_paths;
-
-        while (g_extract_modal_show)
-        {
-            if (g_extract_modal_index >= dravex::package::instance().get_entry_count())
-                break;
-
-            // Obtain the asset entry information..
-            const auto& entry = dravex::package::instance().get_entry(g_extract_modal_index);
-            if (entry == nullptr)
-            {
-                failed_index.push_back(g_extract_modal_index);
-
-                g_extract_modal_index++;
-                continue;
-            }
-
-            // Obtain the entry information..
-            const auto& data = dravex::package::instance().get_entry_data(g_extract_modal_index);
-            const auto& name = dravex::package::instance().get_string(entry->string_offset_);
-            auto ext         = dravex::package::instance().get_extension(entry->file_type_);
-
-            std::error_code ec{};
-
-            // Prepare the full path to the file..
-            auto fpath = g_extract_modal_path;
-            fpath /= std::format("{}{}", name, ext);
-
-            // Ensure the path to the file exists..
-            if (!std::filesystem::exists(fpath.parent_path(), ec))
-                std::filesystem::create_directories(fpath.parent_path(), ec);
-
-            // Save the asset..
-            FILE* f = nullptr;
-            if (::fopen_s(&f, fpath.string().c_str(), "wb") == ERROR_SUCCESS)
-            {
-                ::fwrite(data.data(), data.size(), 1, f);
-                ::fclose(f);
-            }
-            else
-                failed_paths.push_back(fpath);
-
-            // Step to the next asset..
-            g_extract_modal_index++;
-        }
-
-        dravex::logging::instance().log(dravex::loglevel::info, "[extract] extract all assets completed.");
-
-        if (failed_index.size() > 0)
-        {
-            for (const auto& i : failed_index)
-                dravex::logging::instance().log(dravex::loglevel::error, std::format("[extract] failed to extract asset at index: {}", i));
-        }
-
-        if (failed_paths.size() > 0)
-        {
-            for (const auto& p : failed_paths)
-                dravex::logging::instance().log(dravex::loglevel::error, std::format("[extract] failed to extract asset to path: {}", p.string()));
-        }
-    });
+    // Start the extraction and mark the extraction overlay to display..
+    if (g_extractor.start(g_package, opts))
+        g_extract_modal_show = true;
 }
 
 /**
@@ -236,18 +214,25 @@ void extract_assets_overlay(void)
 
     if (ImGui::BeginPopupModal("Extracting..###dravex_extract_overlay", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
     {
-        const auto entry_count = dravex::package::instance().get_entry_count();
+        const auto entry_count = g_extractor.get_total();
+        const auto completed   = g_extractor.get_completed();
 
-        ImGui::Text(std::format("Extracting asset {} of {}..", g_extract_modal_index, entry_count).c_str());
-        ImGui::ProgressBar(static_cast<float>(g_extract_modal_index) / static_cast<float>(entry_count));
+        ImGui::Text(std::format("Extracting asset {} of {}..", completed, entry_count).c_str());
+        ImGui::ProgressBar(static_cast<float>(completed) / static_cast<float>(entry_count));
         ImGui::Separator();
 
-        if (ImGui::Button("Cancel") || g_extract_modal_index >= entry_count)
+        if (ImGui::Button("Cancel") || completed >= entry_count)
         {
-            g_extract_modal_index = 0;
-            g_extract_modal_path  = "";
-            g_extract_modal_show  = false;
-            g_extract_modal_thread.join();
+            g_extractor.cancel();
+            g_extractor.wait();
+            g_extract_modal_show = false;
+
+            DRAVEX_LOG(dravex::loglevel::info, "[extract] extract all assets completed; {} unchanged assets skipped.", g_extractor.get_skipped());
+
+            for (const auto& i : g_extractor.get_failed_index())
+                DRAVEX_LOG(dravex::loglevel::error, "[extract] failed to extract asset at index: {}", i);
+            for (const auto& p : g_extractor.get_failed_paths())
+                DRAVEX_LOG(dravex::loglevel::error, "[extract] failed to extract asset to path: {}", p.string());
 
             ImGui::CloseCurrentPopup();
         }
@@ -257,31 +242,30 @@ void extract_assets_overlay(void)
 }
 
 /**
- * Loads the selected asset to be viewed.
+ * Starts loading the selected asset to be viewed in the background.
  */
 void load_selected_asset(void)
 {
-    const auto& e = dravex::package::instance().get_entry(g_pending_asset_index);
+    const auto& e = g_package->get_entry(g_pending_asset_index);
     if (e == nullptr)
         return;
 
+    std::shared_ptr<dravex::assets::asset> asset;
+
     switch (e->file_type_)
     {
         case 0: // tga
         case 1: // bmp
         case 2: // dds
-            g_asset = std::make_shared<dravex::assets::asset_texture>();
-            g_asset->initialize(g_window->get_d3d9dev(), e);
+            asset = std::make_shared<dravex::assets::asset_texture>(g_window->get_d3d9dev());
             break;
 
         case 3: // ttf
-            g_asset = std::make_shared<dravex::assets::asset_font>();
-            g_asset->initialize(g_window->get_d3d9dev(), e);
+            asset = std::make_shared<dravex::assets::asset_font>();
             break;
 
         case 8: // ogg
-            g_asset = std::make_shared<dravex::assets::asset_ogg>();
-            g_asset->initialize(g_window->get_d3d9dev(), e);
+            asset = std::make_shared<dravex::assets::asset_ogg>();
             break;
 
         case 10: // msc
@@ -294,8 +278,7 @@ void load_selected_asset(void)
         case 18: // fx
         case 19: // cfg
         case 20: // txt
-            g_asset = std::make_shared<dravex::assets::asset_text>();
-            g_asset->initialize(g_window->get_d3d9dev(), e);
+            asset = std::make_shared<dravex::assets::asset_text>();
             break;
 
         case 4:  // cobj
@@ -306,10 +289,28 @@ void load_selected_asset(void)
         case 17: // dat
         case 21: // (undefined)
         default:
-            g_asset = std::make_shared<dravex::assets::asset_unknown>();
-            g_asset->initialize(g_window->get_d3d9dev(), e);
+            asset = std::make_shared<dravex::assets::asset_unknown>();
             break;
     }
+
+    dravex::assets::loader::instance().load(g_package, g_pending_asset_index, asset);
+}
+
+/**
+ * Initializes the loaded asset once its background decode has finished.
+ */
+void finalize_loaded_asset(void)
+{
+    std::shared_ptr<dravex::assets::asset> asset;
+    int32_t index = -1;
+
+    if (!dravex::assets::loader::instance().poll(asset, index) || index != g_selected_asset_index)
+        return;
+
+    dravex::tracespan span{"initialize", "asset", index};
+
+    asset->initialize(g_window->get_d3d9dev(), g_package->get_entry(index));
+    g_asset = asset;
 }
 
 /**
@@ -317,24 +318,47 @@ void load_selected_asset(void)
  */
 void render_view_assets(void)
 {
-    const auto entry_count = dravex::package::instance().get_entry_count();
+    // Display the open progress while the package is being opened..
+    if (g_package->is_opening())
+    {
+        const auto progress = g_package->get_open_progress();
+        const auto fraction = progress.total_ == 0 ? 0.0f : static_cast<float>(progress.done_) / static_cast<float>(progress.total_);
+
+        ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), std::format("{} ({} / {})", dravex::package::get_phase_name(progress.phase_), progress.done_, progress.total_).c_str());
+    }
+
+    const auto entry_count = g_package->get_entry_count();
     if (entry_count == 0)
         return;
 
     ImGui::BeginChild("##entry_list", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
 
+    std::string s;
+
     ImGuiListClipper clipper;
     clipper.Begin(entry_count);
 
+    auto visible_start = 0;
+    auto visible_end   = 0;
+
     while (clipper.Step())
     {
+        // Track the widest range displayed as the visible range..
+        if (clipper.DisplayEnd - clipper.DisplayStart > visible_end - visible_start)
+        {
+            visible_start = clipper.DisplayStart;
+            visible_end   = clipper.DisplayEnd;
+        }
+
         for (auto x = clipper.DisplayStart; x < clipper.DisplayEnd; x++)
         {
-            const auto e    = dravex::package::instance().get_entry(x);
-            const auto& s   = dravex::package::instance().get_string(e->string_offset_);
+            const auto e    = g_package->get_entry(x);
             const auto& ext = dravex::package::get_extension(e->file_type_);
 
-            if (ImGui::Selectable(std::format("{}{}##entry_{}", s == nullptr ? "(unknown)" : s, ext, x).c_str(), x == g_selected_asset_index))
+            if (!g_package->get_entry_name(x, s))
+                s = "(unknown)";
+
+            if (ImGui::Selectable(std::format("{}{}##entry_{}", s, ext, x).c_str(), x == g_selected_asset_index))
             {
                 if (g_selected_asset_index != x)
                 {
@@ -349,7 +373,7 @@ void render_view_assets(void)
             if (ImGui::IsItemHovered())
             {
                 ImGui::BeginTooltip();
-                ImGui::Text(std::format("{}{}", s == nullptr ? "(unknown)" : s, ext).c_str());
+                ImGui::Text(std::format("{}{}", s, ext).c_str());
                 ImGui::Separator();
                 ImGui::Text(std::format("       Compressed : {}", e->is_compressed_ ? "True" : "False").c_str());
                 ImGui::Text(std::format("  Size Compressed : {}", e->size_compressed_).c_str());
@@ -369,6 +393,9 @@ void render_view_assets(void)
     }
 
     ImGui::EndChild();
+
+    // Warm the entries ahead of the selection or scrolling direction..
+    dravex::prefetcher::instance().update(g_package, g_selected_asset_index, visible_start, visible_end);
 }
 
 /**
@@ -376,7 +403,40 @@ void render_view_assets(void)
  */
 void render_view_logging(void)
 {
-    dravex::logging::instance().render();
+    if (ImGui::BeginTabBar("##log_tabbar", ImGuiTabBarFlags_NoCloseWithMiddleMouseButton))
+    {
+        if (ImGui::BeginTabItem(ICON_FA_LIST "Log", nullptr, ImGuiTabItemFlags_NoCloseButton | ImGuiTabItemFlags_NoCloseWithMiddleMouseButton))
+        {
+            dravex::logging::instance().render();
+            ImGui::EndTabItem();
+        }
+
+        if (ImGui::BeginTabItem(ICON_FA_GAUGE "Statistics", nullptr, ImGuiTabItemFlags_NoCloseButton | ImGuiTabItemFlags_NoCloseWithMiddleMouseButton))
+        {
+            dravex::stats::instance().render();
+
+            // Display the entry cache state..
+            const auto cache = g_package->get_cache().get_stats();
+            ImGui::Separator();
+            ImGui::Text(std::format("Entry Cache: {} entries, {:.2f} / {:.2f} MB - hits: {}, misses: {}, evictions: {}",
+                                    cache.entries_, static_cast<double>(cache.bytes_) / 1048576.0, static_cast<double>(cache.budget_) / 1048576.0,
+                                    cache.hits_, cache.misses_, cache.evictions_)
+                            .c_str());
+            ImGui::Text(std::format("Package Index: {} bytes, {} directories", g_package->get_index_size(), g_package->get_directory_count()).c_str());
+
+            // Display the front-coded name savings..
+            const auto& names = g_package->get_name_store();
+            if (names.get_count() > 0)
+            {
+                ImGui::Text(std::format("Compact Names: {} bytes, {} bytes verbatim ({:.1f}% saved)", names.get_size(), names.get_raw_size(),
+                                        100.0 - static_cast<double>(names.get_size()) * 100.0 / static_cast<double>(std::max<std::size_t>(1, names.get_raw_size())))
+                                .c_str());
+            }
+            ImGui::EndTabItem();
+        }
+
+        ImGui::EndTabBar();
+    }
 }
 
 /**
@@ -384,6 +444,19 @@ void render_view_logging(void)
  */
 void render_view_main(void)
 {
+    // Display a placeholder while the selected asset is loading..
+    if (dravex::assets::loader::instance().is_loading())
+    {
+        const char* spinner[] = {"|", "/", "-", "\\"};
+        const auto frame      = static_cast<uint32_t>(ImGui::GetTime() * 8.0) % 4;
+
+        std::string name;
+        g_package->get_entry_name(dravex::assets::loader::instance().get_loading_index(), name);
+
+        ImGui::TextColored(ImVec4(0.0f, 0.9f, 1.0f, 1.0f), std::format(ICON_FA_SPINNER "Loading {}.. {}", name, spinner[frame]).c_str());
+        return;
+    }
+
     if (g_asset)
         g_asset->render();
 }
@@ -419,13 +492,19 @@ bool __stdcall on_reset(const bool is_pre_reset)
  */
 void __stdcall on_update(void)
 {
-    // Load pending asset prior to ImGui frame..
+    // Drain the pending log messages..
+    dravex::logging::instance().flush();
+
+    // Start loading the pending asset in the background..
     if (g_has_pending_asset)
     {
         load_selected_asset();
         g_has_pending_asset = false;
     }
 
+    // Finalize the loaded asset prior to ImGui frame..
+    finalize_loaded_asset();
+
     dravex::imguimgr::instance().beginscene();
     {
         if (ImGui::BeginMainMenuBar())
@@ -454,20 +533,27 @@ void __stdcall on_update(void)
                     {
                         reset_asset_variables();
 
-                        dravex::package::instance().close();
-                        dravex::package::instance().open(file_path);
+                        dravex::assets::loader::instance().wait();
+                        dravex::prefetcher::instance().cancel();
+                        dravex::prefetcher::instance().wait();
+                        g_package->close();
+                        g_package->open_async(file_path);
                     }
                 }
                 if (ImGui::MenuItem(ICON_FA_FOLDER_CLOSED "Close"))
                 {
                     reset_asset_variables();
 
-                    dravex::package::instance().close();
+                    dravex::assets::loader::instance().wait();
+                    dravex::prefetcher::instance().cancel();
+                    dravex::prefetcher::instance().wait();
+                    g_package->close();
                 }
                 ImGui::Separator();
-                if (ImGui::MenuItem(ICON_FA_ANGLE_DOWN "Extract Selected Asset"))
+                const auto opening = g_package->is_opening();
+                if (ImGui::MenuItem(ICON_FA_ANGLE_DOWN "Extract Selected Asset", nullptr, false, !opening))
                     extract_asset();
-                if (ImGui::MenuItem(ICON_FA_ANGLES_DOWN "Extract All Assets"))
+                if (ImGui::MenuItem(ICON_FA_ANGLES_DOWN "Extract All Assets", nullptr, false, !opening))
                     extract_assets();
                 ImGui::Separator();
                 if (ImGui::MenuItem(ICON_FA_RECTANGLE_XMARK "Exit"))
@@ -475,6 +561,26 @@ void __stdcall on_update(void)
                 ImGui::EndMenu();
             }
 
+            if (ImGui::BeginMenu("Tools"))
+            {
+                auto tracing = dravex::tracing::instance().is_enabled();
+                if (ImGui::MenuItem(ICON_FA_TIMELINE "Record Trace", nullptr, &tracing))
+                    dravex::tracing::instance().set_enabled(tracing);
+                if (ImGui::MenuItem(ICON_FA_FILE_EXPORT "Export Trace"))
+                    export_trace();
+                if (ImGui::MenuItem(ICON_FA_TRASH "Clear Trace"))
+                    dravex::tracing::instance().clear();
+                ImGui::Separator();
+                auto compact = g_package->get_compact_names();
+                if (ImGui::MenuItem(ICON_FA_COMPRESS "Compact Names", nullptr, &compact, !g_package->is_opening()))
+                    g_package->set_compact_names(compact);
+                auto prefetch = dravex::prefetcher::instance().get_enabled();
+                if (ImGui::MenuItem(ICON_FA_FORWARD "Prefetch Neighbours", nullptr, &prefetch))
+                    dravex::prefetcher::instance().set_enabled(prefetch);
+                ImGui::MenuItem(ICON_FA_ARROWS_ROTATE "Incremental Extract", nullptr, &g_extract_incremental);
+                ImGui::EndMenu();
+            }
+
             if (ImGui::BeginMenu("Help"))
             {
                 if (ImGui::MenuItem(ICON_FA_GITHUB "GitHub Repo"))
@@ -486,6 +592,8 @@ void __stdcall on_update(void)
                 ImGui::Separator();
                 if (ImGui::MenuItem(ICON_FA_CIRCLE_INFO "About dravex"))
                 {
+                    dravex::assets::loader::instance().cancel();
+
                     g_asset = std::make_shared<dravex::assets::asset_splash>();
                     g_asset->initialize(g_window->get_d3d9dev(), nullptr);
                 }
@@ -578,7 +686,8 @@ int32_t __cdecl main(int32_t argc, char* argv[])
               << std::endl
               << std::endl;
 
-    dravex::logging::instance().log(dravex::loglevel::info, "[info] dravex - Dungeon Runners Asset Viewer & Extractor - (c) 2022 atom0s [atom0s@live.com]");
+    DRAVEX_LOG(dravex::loglevel::info, "[info] dravex - Dungeon Runners Asset Viewer & Extractor - (c) 2022 atom0s [atom0s@live.com]");
+    dravex::tracing::instance().set_thread_name("main");
 
     /**
      * Runs the application.
@@ -586,6 +695,9 @@ int32_t __cdecl main(int32_t argc, char* argv[])
      * @return {bool} True on success, false otherwise.
      */
     const auto run_application = [](void) -> bool {
+        // Create the package being viewed..
+        g_package = dravex::package::create();
+
         // Initialize the window..
         g_window = std::make_shared<dravex::window>();
         if (!g_window->initialize())
@@ -616,16 +728,15 @@ int32_t __cdecl main(int32_t argc, char* argv[])
     // Run the application..
     const auto ret = run_application();
 
-    // Stop the extraction thread if running..
-    if (g_extract_modal_show || g_extract_modal_thread.joinable())
-    {
-        g_extract_modal_show = false;
-        g_extract_modal_thread.join();
-    }
+    // Stop the extraction threads if running..
+    g_extract_modal_show = false;
+    g_extractor.cancel();
+    g_extractor.wait();
 
     // Cleanup..
     dravex::imguimgr::instance().release();
-    dravex::package::instance().close();
+    if (g_package)
+        g_package->close();
 
     if (g_asset)
         g_asset->release();
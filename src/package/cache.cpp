@@ -0,0 +1,330 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "cache.hpp"
+#include "../stats.hpp"
+
+/**
+ * Constructor and Destructor
+ *
+ * @param {uint64_t} budget - The maximum number of decompressed bytes the cache may hold.
+ */
+dravex::entrycache::entrycache(const uint64_t budget)
+    : budget_{budget}
+    , bytes_{0}
+    , hits_{0}
+    , misses_{0}
+    , evictions_{0}
+{}
+dravex::entrycache::~entrycache(void)
+{
+    this->clear();
+}
+
+/**
+ * Returns the shard that owns the given entry index.
+ *
+ * @param {int32_t} index - The entry index.
+ * @return {shard_t&} The owning shard.
+ */
+dravex::entrycache::shard_t& dravex::entrycache::get_shard(const int32_t index)
+{
+    return this->shards_[static_cast<uint32_t>(index) % shard_count];
+}
+
+/**
+ * Returns the buffer of the given entry held by a shard, marking it as the most recently used.
+ *
+ * @param {shard_t&} shard - The shard to search.
+ * @param {int32_t} index - The entry index.
+ * @return {dravex::entrybuffer_t} The cached buffer if found, nullptr otherwise.
+ */
+dravex::entrybuffer_t dravex::entrycache::find(shard_t& shard, const int32_t index)
+{
+    std::lock_guard<std::mutex> lock{shard.mutex_};
+
+    const auto iter = shard.lookup_.find(index);
+    if (iter == shard.lookup_.end())
+        return nullptr;
+
+    shard.lru_.splice(shard.lru_.begin(), shard.lru_, iter->second);
+    return std::get<1>(*iter->second);
+}
+
+/**
+ * Removes the buffer of the given entry from a shard, if held.
+ *
+ * @param {shard_t&} shard - The shard to remove from. (Must be locked by the caller.)
+ * @param {int32_t} index - The entry index.
+ */
+void dravex::entrycache::remove(shard_t& shard, const int32_t index)
+{
+    const auto iter = shard.lookup_.find(index);
+    if (iter == shard.lookup_.end())
+        return;
+
+    const auto size = std::get<1>(*iter->second)->size();
+    shard.bytes_ -= size;
+    this->bytes_.fetch_sub(size, std::memory_order_relaxed);
+
+    shard.lru_.erase(iter->second);
+    shard.lookup_.erase(iter);
+}
+
+/**
+ * Evicts the least recently used entry of a shard.
+ *
+ * @param {shard_t&} shard - The shard to evict from. (Must be locked by the caller and not empty.)
+ */
+void dravex::entrycache::evict(shard_t& shard)
+{
+    const auto& [index, buffer] = shard.lru_.back();
+
+    shard.bytes_ -= buffer->size();
+    this->bytes_.fetch_sub(buffer->size(), std::memory_order_relaxed);
+    shard.lookup_.erase(index);
+    shard.lru_.pop_back();
+
+    this->evictions_.fetch_add(1, std::memory_order_relaxed);
+    dravex::stats::instance().add(dravex::counter::cache_evictions, 1);
+}
+
+/**
+ * Evicts the least recently used entries of a shard until it fits within the given budget.
+ *
+ * @param {shard_t&} shard - The shard to trim. (Must be locked by the caller.)
+ * @param {uint64_t} budget - The byte budget of the shard.
+ */
+void dravex::entrycache::trim(shard_t& shard, const uint64_t budget)
+{
+    while (shard.bytes_ > budget && !shard.lru_.empty())
+        this->evict(shard);
+}
+
+/**
+ * Evicts entries across the shards until the whole cache fits within the given budget.
+ *
+ * The large entry shard is trimmed first, as its entries free the most memory. The shard that was just
+ * inserted into is trimmed last, so the new entry is kept whenever the other shards can make room for it.
+ * Only a single shard is locked at a time.
+ *
+ * @param {shard_t&} owner - The shard that was just inserted into. (Must not be locked by the caller.)
+ * @param {uint64_t} budget - The byte budget of the cache.
+ */
+void dravex::entrycache::balance(shard_t& owner, const uint64_t budget)
+{
+    const auto drain = [this, budget](shard_t& shard) {
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+        while (this->bytes_.load(std::memory_order_relaxed) > budget && !shard.lru_.empty())
+            this->evict(shard);
+    };
+
+    if (&owner != &this->large_)
+        drain(this->large_);
+
+    for (auto& shard : this->shards_)
+    {
+        if (this->bytes_.load(std::memory_order_relaxed) <= budget)
+            return;
+        if (&shard != &owner)
+            drain(shard);
+    }
+
+    if (this->bytes_.load(std::memory_order_relaxed) > budget)
+        drain(owner);
+}
+
+/**
+ * Returns the cached buffer of the given entry, marking it as the most recently used.
+ *
+ * @param {int32_t} index - The entry index.
+ * @return {dravex::entrybuffer_t} The cached buffer on hit, nullptr on miss.
+ */
+dravex::entrybuffer_t dravex::entrycache::get(const int32_t index)
+{
+    auto buffer = this->find(this->get_shard(index), index);
+    if (buffer == nullptr)
+        buffer = this->find(this->large_, index);
+
+    if (buffer == nullptr)
+    {
+        this->misses_.fetch_add(1, std::memory_order_relaxed);
+        dravex::stats::instance().add(dravex::counter::cache_misses, 1);
+        return nullptr;
+    }
+
+    this->hits_.fetch_add(1, std::memory_order_relaxed);
+    dravex::stats::instance().add(dravex::counter::cache_hits, 1);
+    return buffer;
+}
+
+/**
+ * Inserts (or replaces) the buffer of the given entry.
+ *
+ * Buffers larger than the budget share of a single shard are held in the large entry shard, which may use
+ * the whole budget. Buffers larger than the whole budget are not cached.
+ *
+ * @param {int32_t} index - The entry index.
+ * @param {dravex::entrybuffer_t&} buffer - The decompressed entry data.
+ */
+void dravex::entrycache::put(const int32_t index, const dravex::entrybuffer_t& buffer)
+{
+    const auto budget = this->budget_.load(std::memory_order_relaxed);
+    if (buffer == nullptr || buffer->size() > budget)
+        return;
+
+    auto& small = this->get_shard(index);
+    auto& owner = buffer->size() > budget / shard_count ? this->large_ : small;
+    auto& other = &owner == &small ? this->large_ : small;
+
+    // Drop any existing buffer of the entry held by the other shard..
+    {
+        std::lock_guard<std::mutex> lock{other.mutex_};
+        this->remove(other, index);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{owner.mutex_};
+
+        // Replace any existing buffer of the entry..
+        this->remove(owner, index);
+
+        owner.lru_.emplace_front(index, buffer);
+        owner.lookup_[index] = owner.lru_.begin();
+        owner.bytes_ += buffer->size();
+        this->bytes_.fetch_add(buffer->size(), std::memory_order_relaxed);
+
+        this->trim(owner, &owner == &this->large_ ? budget : budget / shard_count);
+    }
+
+    this->balance(owner, budget);
+}
+
+/**
+ * Returns if the given entry is cached, without marking it as used or counting a hit or miss.
+ *
+ * @param {int32_t} index - The entry index.
+ * @return {bool} True if cached, false otherwise.
+ */
+bool dravex::entrycache::contains(const int32_t index)
+{
+    for (auto shard : {&this->get_shard(index), &this->large_})
+    {
+        std::lock_guard<std::mutex> lock{shard->mutex_};
+        if (shard->lookup_.find(index) != shard->lookup_.end())
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Removes all entries from the cache.
+ */
+void dravex::entrycache::clear(void)
+{
+    for (auto& shard : this->shards_)
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+
+        this->bytes_.fetch_sub(shard.bytes_, std::memory_order_relaxed);
+        shard.lru_.clear();
+        shard.lookup_.clear();
+        shard.bytes_ = 0;
+    }
+
+    std::lock_guard<std::mutex> lock{this->large_.mutex_};
+
+    this->bytes_.fetch_sub(this->large_.bytes_, std::memory_order_relaxed);
+    this->large_.lru_.clear();
+    this->large_.lookup_.clear();
+    this->large_.bytes_ = 0;
+}
+
+/**
+ * Returns the byte budget of the cache.
+ *
+ * @return {uint64_t} The byte budget.
+ */
+uint64_t dravex::entrycache::get_budget(void) const
+{
+    return this->budget_.load(std::memory_order_relaxed);
+}
+
+/**
+ * Sets the byte budget of the cache, evicting entries if the cache no longer fits.
+ *
+ * @param {uint64_t} budget - The maximum number of decompressed bytes the cache may hold.
+ */
+void dravex::entrycache::set_budget(const uint64_t budget)
+{
+    this->budget_.store(budget, std::memory_order_relaxed);
+
+    for (auto& shard : this->shards_)
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+        this->trim(shard, budget / shard_count);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{this->large_.mutex_};
+        this->trim(this->large_, budget);
+    }
+
+    this->balance(this->large_, budget);
+}
+
+/**
+ * Returns a snapshot of the cache statistics.
+ *
+ * @return {dravex::cachestats_t} The cache statistics.
+ */
+dravex::cachestats_t dravex::entrycache::get_stats(void)
+{
+    dravex::cachestats_t stats{};
+    stats.hits_      = this->hits_.load(std::memory_order_relaxed);
+    stats.misses_    = this->misses_.load(std::memory_order_relaxed);
+    stats.evictions_ = this->evictions_.load(std::memory_order_relaxed);
+    stats.budget_    = this->budget_.load(std::memory_order_relaxed);
+
+    for (auto& shard : this->shards_)
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+
+        stats.entries_ += shard.lru_.size();
+        stats.bytes_ += shard.bytes_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{this->large_.mutex_};
+
+        stats.entries_ += this->large_.lru_.size();
+        stats.bytes_ += this->large_.bytes_;
+    }
+
+    return stats;
+}
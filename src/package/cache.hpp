@@ -0,0 +1,119 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PACKAGE_CACHE_HPP
+#define PACKAGE_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "../bufferpool.hpp"
+
+namespace dravex
+{
+    /**
+     * Shared, immutable buffer holding the decompressed data of a package entry.
+     *
+     * Buffers are reference counted; evicting an entry from the cache never invalidates a buffer still held by a caller.
+     */
+    using entrybuffer_t = std::shared_ptr<const dravex::bytebuffer_t>;
+
+    /**
+     * Structure definition for a snapshot of the entry cache state.
+     */
+    struct cachestats_t
+    {
+        uint64_t hits_;
+        uint64_t misses_;
+        uint64_t evictions_;
+        uint64_t entries_;
+        uint64_t bytes_;
+        uint64_t budget_;
+    };
+
+    class entrycache final
+    {
+        entrycache(entrycache const&)            = delete;
+        entrycache(entrycache&&)                 = delete;
+        entrycache& operator=(entrycache const&) = delete;
+        entrycache& operator=(entrycache&&)      = delete;
+
+    public:
+        static constexpr std::size_t shard_count = 16;
+
+    private:
+        /**
+         * Structure definition for a single lock domain of the cache.
+         *
+         * Each shard holds its own recency list (most recent first) and lookup table.
+         */
+        struct shard_t
+        {
+            std::mutex mutex_;
+            std::list<std::tuple<int32_t, dravex::entrybuffer_t>> lru_;
+            std::unordered_map<int32_t, std::list<std::tuple<int32_t, dravex::entrybuffer_t>>::iterator> lookup_;
+            uint64_t bytes_;
+
+            shard_t(void)
+                : bytes_{0}
+            {}
+        };
+
+        std::array<shard_t, shard_count> shards_;
+        shard_t large_; // Holds the entries larger than the budget share of a single shard.
+        std::atomic<uint64_t> budget_;
+        std::atomic<uint64_t> bytes_;
+        std::atomic<uint64_t> hits_;
+        std::atomic<uint64_t> misses_;
+        std::atomic<uint64_t> evictions_;
+
+        auto get_shard(const int32_t index) -> shard_t&;
+        auto find(shard_t& shard, const int32_t index) -> dravex::entrybuffer_t;
+        auto remove(shard_t& shard, const int32_t index) -> void;
+        auto evict(shard_t& shard) -> void;
+        auto trim(shard_t& shard, const uint64_t budget) -> void;
+        auto balance(shard_t& owner, const uint64_t budget) -> void;
+
+    public:
+        entrycache(const uint64_t budget);
+        ~entrycache(void);
+
+        auto get(const int32_t index) -> dravex::entrybuffer_t;
+        auto put(const int32_t index, const dravex::entrybuffer_t& buffer) -> void;
+        auto contains(const int32_t index) -> bool;
+        auto clear(void) -> void;
+
+        auto get_budget(void) const -> uint64_t;
+        auto set_budget(const uint64_t budget) -> void;
+        auto get_stats(void) -> dravex::cachestats_t;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_CACHE_HPP
@@ -0,0 +1,258 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "contentstore.hpp"
+#include "../logging.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
+#include "../utils.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::contentstore::contentstore(void)
+    : counts_{}
+    , bytes_{}
+{}
+dravex::contentstore::~contentstore(void)
+{
+    this->close();
+}
+
+/**
+ * Writes the object of the given content, unless it already exists.
+ *
+ * @param {std::string&} digest - The content digest.
+ * @param {uint8_t*} data - The content data.
+ * @param {std::size_t} size - The content size.
+ * @return {dravex::storeresult} The store result.
+ */
+dravex::storeresult dravex::contentstore::write(const std::string& digest, const uint8_t* data, const std::size_t size) const
+{
+    dravex::scopedtimer timer{dravex::stage::write};
+    dravex::tracespan span{"write", "store"};
+
+    const auto path = this->get_object_path(digest);
+
+    // Reuse the object left by a previous session.. (Objects are only given their final name once fully written.)
+    std::error_code ec{};
+    const auto existing = std::filesystem::file_size(path, ec);
+    if (!ec && existing == size)
+        return dravex::storeresult::reused;
+
+    // Write the object under a temporary name..
+    const auto temp = path + ".part";
+
+    FILE* f = nullptr;
+    if (::fopen_s(&f, temp.c_str(), "wb") != ERROR_SUCCESS)
+        return dravex::storeresult::failed;
+
+    auto written = size == 0 || ::fwrite(data, size, 1, f) == 1;
+    written      = ::fclose(f) == 0 && written;
+
+    if (!written)
+    {
+        std::filesystem::remove(temp, ec);
+        return dravex::storeresult::failed;
+    }
+
+    // Give the object its final name..
+    std::filesystem::rename(temp, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp, ec);
+        return dravex::storeresult::failed;
+    }
+
+    dravex::stats::instance().add(dravex::counter::bytes_written, size);
+    return dravex::storeresult::stored;
+}
+
+/**
+ * Records the given put result in the store counters.
+ *
+ * @param {dravex::storeresult} result - The put result.
+ * @param {std::size_t} size - The content size.
+ * @return {dravex::storeresult} The put result.
+ */
+dravex::storeresult dravex::contentstore::record(const dravex::storeresult result, const std::size_t size)
+{
+    this->counts_[static_cast<uint32_t>(result)]++;
+    this->bytes_[static_cast<uint32_t>(result)] += size;
+    return result;
+}
+
+/**
+ * Opens the store at the given directory, creating it if needed.
+ *
+ * @param {std::filesystem::path&} root - The store directory.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::contentstore::open(const std::filesystem::path& root)
+{
+    this->close();
+
+    std::error_code ec{};
+    if (!std::filesystem::exists(root, ec))
+        std::filesystem::create_directories(root, ec);
+
+    if (!std::filesystem::is_directory(root, ec))
+    {
+        DRAVEX_LOG(dravex::loglevel::error, "[contentstore] failed to create the store directory: {}", root.string());
+        return false;
+    }
+
+    // Create the object directories up front, so writing an object needs no directory checks..
+    for (uint32_t x = 0; x < 256; x++)
+    {
+        const uint8_t b = static_cast<uint8_t>(x);
+        std::filesystem::create_directory(root / dravex::utils::to_hex(&b, 1), ec);
+    }
+
+    this->root_ = root;
+    return true;
+}
+
+/**
+ * Closes the store, forgetting the content put during the session. (The objects are kept on disk.)
+ */
+void dravex::contentstore::close(void)
+{
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    this->root_.clear();
+    this->objects_.clear();
+
+    for (auto& c : this->counts_)
+        c = 0;
+    for (auto& b : this->bytes_)
+        b = 0;
+}
+
+/**
+ * Puts the given content into the store.
+ *
+ * @param {uint8_t*} data - The content data.
+ * @param {std::size_t} size - The content size.
+ * @param {std::string&} digest - The string to hold the content digest, as hex.
+ * @return {dravex::storeresult} The store result.
+ */
+dravex::storeresult dravex::contentstore::put(const uint8_t* data, const std::size_t size, std::string& digest)
+{
+    std::array<uint8_t, 32> hash{};
+    {
+        dravex::tracespan span{"hash", "store"};
+        if (!dravex::utils::sha256(data, size, hash))
+            return this->record(dravex::storeresult::failed, size);
+    }
+
+    digest = dravex::utils::to_hex(hash.data(), hash.size());
+
+    // Claim the object, or obtain the pending write of the thread that claimed it..
+    std::promise<bool> promise;
+    std::shared_future<bool> pending;
+    {
+        std::lock_guard<std::mutex> lock{this->mutex_};
+
+        const auto [iter, inserted] = this->objects_.try_emplace(digest);
+        if (inserted)
+            iter->second = promise.get_future().share();
+        else
+            pending = iter->second;
+    }
+
+    // Wait for the object to be written by its owning thread..
+    if (pending.valid())
+        return this->record(pending.get() ? dravex::storeresult::duplicate : dravex::storeresult::failed, size);
+
+    const auto result = this->write(digest, data, size);
+    promise.set_value(result != dravex::storeresult::failed);
+
+    return this->record(result, size);
+}
+
+/**
+ * Creates a hard link to the object of the given digest at the given path, replacing any existing file.
+ *
+ * @param {std::string&} digest - The content digest.
+ * @param {std::string&} path - The path of the link.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::contentstore::link(const std::string& digest, const std::string& path) const
+{
+    const auto object = this->get_object_path(digest);
+
+    ::DeleteFileA(path.c_str());
+    return ::CreateHardLinkA(path.c_str(), object.c_str(), nullptr) != FALSE;
+}
+
+/**
+ * Returns the store directory.
+ *
+ * @return {std::filesystem::path&} The store directory.
+ */
+const std::filesystem::path& dravex::contentstore::get_root(void) const
+{
+    return this->root_;
+}
+
+/**
+ * Returns the path of the object of the given digest.
+ *
+ * @param {std::string&} digest - The content digest.
+ * @return {std::string} The object path.
+ */
+std::string dravex::contentstore::get_object_path(const std::string& digest) const
+{
+    std::string path = this->root_.string();
+    path.append(1, static_cast<char>(std::filesystem::path::preferred_separator));
+    path.append(digest, 0, 2);
+    path.append(1, static_cast<char>(std::filesystem::path::preferred_separator));
+    path.append(digest);
+    return path;
+}
+
+/**
+ * Returns the number of puts that had the given result.
+ *
+ * @param {dravex::storeresult} result - The put result.
+ * @return {uint64_t} The put count.
+ */
+uint64_t dravex::contentstore::get_count(const dravex::storeresult result) const
+{
+    return result < dravex::storeresult::count ? this->counts_[static_cast<uint32_t>(result)].load() : 0;
+}
+
+/**
+ * Returns the content bytes of the puts that had the given result.
+ *
+ * @param {dravex::storeresult} result - The put result.
+ * @return {uint64_t} The content byte count.
+ */
+uint64_t dravex::contentstore::get_bytes(const dravex::storeresult result) const
+{
+    return result < dravex::storeresult::count ? this->bytes_[static_cast<uint32_t>(result)].load() : 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_CONTENTSTORE_HPP
+#define PACKAGE_CONTENTSTORE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Results of putting content into the content store.
+     */
+    enum class storeresult : uint32_t
+    {
+        failed = 0, // The content could not be stored..
+        stored,     // First occurrence; the object was written..
+        reused,     // First occurrence; the object already existed from a previous extraction..
+        duplicate,  // The content was already put during this session..
+        count,
+    };
+
+    /**
+     * Content addressed object store.
+     *
+     * Content is keyed by its SHA-256 digest and written once, to <root>/<first digest byte>/<digest>. Any
+     * number of threads can put content at the same time; a thread putting content that another thread is
+     * still writing waits for that write to finish, so the object exists once put returns. Objects left by a
+     * previous session are reused without being written again, which lets several client versions share one
+     * store.
+     */
+    class contentstore final
+    {
+        contentstore(contentstore const&)            = delete;
+        contentstore(contentstore&&)                 = delete;
+        contentstore& operator=(contentstore const&) = delete;
+        contentstore& operator=(contentstore&&)      = delete;
+
+        std::filesystem::path root_;
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_future<bool>> objects_;
+        std::array<std::atomic<uint64_t>, static_cast<uint32_t>(storeresult::count)> counts_;
+        std::array<std::atomic<uint64_t>, static_cast<uint32_t>(storeresult::count)> bytes_;
+
+        auto write(const std::string& digest, const uint8_t* data, const std::size_t size) const -> storeresult;
+        auto record(const storeresult result, const std::size_t size) -> storeresult;
+
+    public:
+        contentstore(void);
+        ~contentstore(void);
+
+        auto open(const std::filesystem::path& root) -> bool;
+        auto close(void) -> void;
+
+        auto put(const uint8_t* data, const std::size_t size, std::string& digest) -> storeresult;
+        auto link(const std::string& digest, const std::string& path) const -> bool;
+
+        auto get_root(void) const -> const std::filesystem::path&;
+        auto get_object_path(const std::string& digest) const -> std::string;
+        auto get_count(const storeresult result) const -> uint64_t;
+        auto get_bytes(const storeresult result) const -> uint64_t;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_CONTENTSTORE_HPP
@@ -0,0 +1,296 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "differ.hpp"
+#include "../bufferpool.hpp"
+#include "../logging.hpp"
+#include "../trace.hpp"
+#include "../utils.hpp"
+
+namespace
+{
+    /**
+     * The number of entries each worker claims at a time; results are streamed once per batch.
+     */
+    constexpr uint32_t diff_batch_size = 256;
+
+} // namespace
+
+/**
+ * Constructor and Destructor
+ */
+dravex::differ::differ(void)
+    : old_{nullptr}
+    , new_{nullptr}
+    , counts_{}
+    , data_compared_{0}
+    , data_bytes_{0}
+{}
+dravex::differ::~differ(void)
+{}
+
+/**
+ * Returns the display name of the given status.
+ *
+ * @param {dravex::diffstatus} status - The status.
+ * @return {const char*} The status name.
+ */
+const char* dravex::differ::get_status_name(const dravex::diffstatus status)
+{
+    switch (status)
+    {
+        case dravex::diffstatus::unchanged:
+            return "unchanged";
+        case dravex::diffstatus::added:
+            return "added";
+        case dravex::diffstatus::removed:
+            return "removed";
+        case dravex::diffstatus::modified:
+            return "modified";
+        case dravex::diffstatus::count:
+            break;
+    }
+
+    return "unknown";
+}
+
+/**
+ * Compares the given entry pair, reading their data only when the metadata cannot decide.
+ *
+ * @param {int32_t} old_index - The entry index within the old package.
+ * @param {int32_t} new_index - The entry index within the new package.
+ * @return {dravex::diffresult_t} The comparison result.
+ */
+dravex::diffresult_t dravex::differ::compare(const int32_t old_index, const int32_t new_index)
+{
+    const auto a = this->old_->get_entry(old_index);
+    const auto b = this->new_->get_entry(new_index);
+
+    dravex::diffresult_t res{dravex::diffstatus::modified, old_index, new_index, false};
+
+    // Differing sizes or types are always a modification..
+    if (a->size_uncompressed_ != b->size_uncompressed_ || a->file_type_ != b->file_type_)
+        return res;
+
+    // The checksum covers the stored data; it is only comparable between entries stored the same way by the same index version..
+    if (this->old_->get_version() == this->new_->get_version() && a->is_compressed_ == b->is_compressed_)
+    {
+        if (a->checksum_ == b->checksum_ && a->size_compressed_ == b->size_compressed_ && !this->options_.verify_)
+        {
+            res.status_ = dravex::diffstatus::unchanged;
+            return res;
+        }
+
+        // Uncompressed entries store their data as-is; a differing checksum is a modification..
+        if (a->checksum_ != b->checksum_ && !a->is_compressed_)
+            return res;
+    }
+
+    // Compare the data..
+    dravex::tracespan span{"compare", "diff", new_index};
+
+    dravex::pooledbuffer data_a{a->size_uncompressed_};
+    dravex::pooledbuffer data_b{b->size_uncompressed_};
+    res.data_compared_ = true;
+
+    if (!this->old_->read_entry(old_index, data_a.get()) || !this->new_->read_entry(new_index, data_b.get()))
+    {
+        DRAVEX_LOG(dravex::loglevel::error, "[diff] failed to read entry data for comparison; treating as modified - old index: {}, new index: {}", old_index, new_index);
+        return res;
+    }
+
+    this->data_compared_++;
+    this->data_bytes_ += data_a.get().size() + data_b.get().size();
+
+    if (data_a.get() == data_b.get())
+        res.status_ = dravex::diffstatus::unchanged;
+
+    return res;
+}
+
+/**
+ * Counts and streams the given results to the callback, clearing them.
+ *
+ * @param {std::vector&} results - The results to emit.
+ */
+void dravex::differ::emit(std::vector<dravex::diffresult_t>& results)
+{
+    for (const auto& r : results)
+        this->counts_[static_cast<uint32_t>(r.status_)]++;
+
+    if (this->callback_)
+    {
+        std::lock_guard<std::mutex> lock{this->callback_mutex_};
+        for (const auto& r : results)
+        {
+            if (r.status_ != dravex::diffstatus::unchanged || this->options_.unchanged_)
+                this->callback_(r);
+        }
+    }
+
+    results.clear();
+}
+
+/**
+ * Compares the given packages, blocking until all entries are classified.
+ *
+ * Entries of the new package are classified (and streamed) first, followed by the removed entries of the
+ * old package.
+ *
+ * @param {dravex::packageptr_t&} old_pkg - The old package.
+ * @param {dravex::packageptr_t&} new_pkg - The new package.
+ * @param {dravex::diffoptions_t&} options - The comparison options.
+ * @param {dravex::difffn_t&} callback - The callback invoked with each result.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::differ::run(const dravex::packageptr_t& old_pkg, const dravex::packageptr_t& new_pkg, const dravex::diffoptions_t& options, const dravex::difffn_t& callback)
+{
+    dravex::tracespan span{"differ::run", "diff"};
+
+    if (old_pkg == nullptr || new_pkg == nullptr || old_pkg->is_opening() || new_pkg->is_opening())
+        return false;
+
+    this->old_      = old_pkg;
+    this->new_      = new_pkg;
+    this->options_  = options;
+    this->callback_ = callback;
+
+    for (auto& c : this->counts_)
+        c = 0;
+    this->data_compared_ = 0;
+    this->data_bytes_    = 0;
+
+    const auto old_count = static_cast<uint32_t>(this->old_->get_entry_count());
+    const auto new_count = static_cast<uint32_t>(this->new_->get_entry_count());
+    this->matched_.assign(old_count, 0);
+
+    // Lower the memory priority of the compared data when the packages are read in a single pass..
+    const auto low = (this->old_->get_access_pattern() == dravex::accesspattern::sequential || this->new_->get_access_pattern() == dravex::accesspattern::sequential);
+
+    // Join the new entries against the old index, comparing each matched pair..
+    std::atomic<uint32_t> next{0};
+    const auto join = [&]() {
+        std::vector<dravex::diffresult_t> results;
+        results.reserve(diff_batch_size);
+
+        std::string name;
+
+        if (low)
+            dravex::utils::set_memory_priority(true);
+
+        for (auto start = next.fetch_add(diff_batch_size); start < new_count; start = next.fetch_add(diff_batch_size))
+        {
+            const auto end = std::min(start + diff_batch_size, new_count);
+            for (auto x = start; x < end; x++)
+            {
+                const auto index = static_cast<int32_t>(x);
+                const auto match = this->new_->get_entry_name(index, name) ? this->old_->find_entry(name) : -1;
+                if (match < 0)
+                {
+                    results.push_back({dravex::diffstatus::added, -1, index, false});
+                    continue;
+                }
+
+                // Paths are unique within a package; each old entry is matched at most once..
+                this->matched_[match] = 1;
+                results.push_back(this->compare(match, index));
+            }
+
+            this->emit(results);
+        }
+
+        if (low)
+            dravex::utils::set_memory_priority(false);
+    };
+
+    const auto threads = std::clamp<uint32_t>(this->options_.threads_, 1, 64);
+
+    std::vector<std::thread> workers;
+    for (uint32_t x = 1; x < threads; x++)
+    {
+        workers.emplace_back([&join]() {
+            dravex::tracing::instance().set_thread_name("diff worker");
+            join();
+        });
+    }
+    join();
+    for (auto& t : workers)
+        t.join();
+
+    // Stream the old entries that were not matched as removed..
+    std::vector<dravex::diffresult_t> results;
+    for (uint32_t x = 0; x < old_count; x++)
+    {
+        if (this->matched_[x] == 0)
+            results.push_back({dravex::diffstatus::removed, static_cast<int32_t>(x), -1, false});
+
+        if (results.size() >= diff_batch_size)
+            this->emit(results);
+    }
+    this->emit(results);
+
+    DRAVEX_LOG(dravex::loglevel::info, "[diff] {} added, {} removed, {} modified, {} unchanged; {} compared by data ({} bytes)",
+               this->get_count(dravex::diffstatus::added), this->get_count(dravex::diffstatus::removed), this->get_count(dravex::diffstatus::modified),
+               this->get_count(dravex::diffstatus::unchanged), this->data_compared_.load(), this->data_bytes_.load());
+
+    this->old_      = nullptr;
+    this->new_      = nullptr;
+    this->callback_ = nullptr;
+    this->matched_.clear();
+
+    return true;
+}
+
+/**
+ * Returns the count of entries classified with the given status by the last comparison.
+ *
+ * @param {dravex::diffstatus} status - The status.
+ * @return {uint64_t} The count of entries.
+ */
+uint64_t dravex::differ::get_count(const dravex::diffstatus status) const
+{
+    return status >= dravex::diffstatus::count ? 0 : this->counts_[static_cast<uint32_t>(status)].load();
+}
+
+/**
+ * Returns the count of entry pairs compared by data by the last comparison.
+ *
+ * @return {uint64_t} The count of entry pairs.
+ */
+uint64_t dravex::differ::get_data_compared(void) const
+{
+    return this->data_compared_;
+}
+
+/**
+ * Returns the count of bytes read to compare entries by data by the last comparison.
+ *
+ * @return {uint64_t} The count of bytes.
+ */
+uint64_t dravex::differ::get_data_bytes(void) const
+{
+    return this->data_bytes_;
+}
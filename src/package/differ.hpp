@@ -0,0 +1,128 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_DIFFER_HPP
+#define PACKAGE_DIFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "package.hpp"
+
+namespace dravex
+{
+    /**
+     * Classification of an entry when comparing two packages.
+     */
+    enum class diffstatus : uint32_t
+    {
+        unchanged = 0,
+        added,
+        removed,
+        modified,
+        count,
+    };
+
+    /**
+     * Structure definition for the result of comparing an entry of two packages.
+     */
+    struct diffresult_t
+    {
+        dravex::diffstatus status_;
+        int32_t old_index_; // -1 if added.
+        int32_t new_index_; // -1 if removed.
+        bool data_compared_;
+    };
+
+    /**
+     * Structure definition for the options used when comparing two packages.
+     */
+    struct diffoptions_t
+    {
+        uint32_t threads_;
+        bool verify_;
+        bool unchanged_;
+
+        diffoptions_t(void)
+            : threads_{1}
+            , verify_{false}
+            , unchanged_{false}
+        {}
+    };
+
+    /**
+     * Callback invoked with the results of a comparison. (Invoked from the worker threads, one call at a time.)
+     */
+    using difffn_t = std::function<void(const dravex::diffresult_t&)>;
+
+    /**
+     * Package comparison engine.
+     *
+     * Joins the entries of two packages by their normalized path and classifies them from their metadata;
+     * differing sizes or file types are modified, while equal checksums of entries stored the same way by the
+     * same index version are unchanged. Only entries the metadata cannot decide are read and compared by data.
+     * Entries are compared in parallel and the results are streamed to the callback as they are classified.
+     */
+    class differ final
+    {
+        differ(differ const&)            = delete;
+        differ(differ&&)                 = delete;
+        differ& operator=(differ const&) = delete;
+        differ& operator=(differ&&)      = delete;
+
+        dravex::packageptr_t old_;
+        dravex::packageptr_t new_;
+        dravex::diffoptions_t options_;
+        dravex::difffn_t callback_;
+        std::mutex callback_mutex_;
+
+        std::vector<uint8_t> matched_;
+        std::array<std::atomic<uint64_t>, static_cast<uint32_t>(dravex::diffstatus::count)> counts_;
+        std::atomic<uint64_t> data_compared_;
+        std::atomic<uint64_t> data_bytes_;
+
+        auto compare(const int32_t old_index, const int32_t new_index) -> dravex::diffresult_t;
+        auto emit(std::vector<dravex::diffresult_t>& results) -> void;
+
+    public:
+        differ(void);
+        ~differ(void);
+
+        static const char* get_status_name(const dravex::diffstatus status);
+
+    public:
+        auto run(const dravex::packageptr_t& old_pkg, const dravex::packageptr_t& new_pkg, const dravex::diffoptions_t& options, const dravex::difffn_t& callback) -> bool;
+
+        auto get_count(const dravex::diffstatus status) const -> uint64_t;
+        auto get_data_compared(void) const -> uint64_t;
+        auto get_data_bytes(void) const -> uint64_t;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_DIFFER_HPP
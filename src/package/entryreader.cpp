@@ -0,0 +1,423 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "entryreader.hpp"
+#include "../logging.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::entryreader::entryreader(void)
+    : package_{nullptr}
+    , entry_{nullptr}
+    , index_{-1}
+    , stream_{}
+    , stream_ready_{false}
+    , input_(chunk_size)
+    , input_offset_{0}
+    , position_{0}
+    , ended_{false}
+    , failed_{false}
+    , access_{nullptr}
+    , building_{nullptr}
+    , span_{0}
+{
+    this->stream_ready_ = inflateInit(&this->stream_) == Z_OK;
+}
+dravex::entryreader::~entryreader(void)
+{
+    if (this->stream_ready_)
+        inflateEnd(&this->stream_);
+}
+
+/**
+ * Opens the reader over the given package entry.
+ *
+ * @param {dravex::package*} pkg - The package holding the entry.
+ * @param {int32_t} index - The entry index.
+ * @param {bool} record - True to record access points when the entry is read in full. (Off for single pass reads.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::entryreader::open(dravex::package* pkg, const int32_t index, const bool record)
+{
+    this->close();
+
+    const auto entry = pkg == nullptr ? nullptr : pkg->get_entry(index);
+    if (entry == nullptr)
+        return false;
+
+    if (entry->is_compressed_ && (!this->stream_ready_ || inflateReset2(&this->stream_, MAX_WBITS) != Z_OK))
+        return false;
+
+    this->package_ = pkg;
+    this->entry_   = entry;
+    this->index_   = index;
+
+    // Use the access points of the entry, or record them while it is read in full when it is large enough..
+    if (entry->is_compressed_)
+    {
+        this->access_ = pkg->get_access_index(index);
+        this->span_   = pkg->get_access_span();
+
+        if (record && this->access_ == nullptr && this->span_ != 0 && entry->size_uncompressed_ / 2 >= this->span_)
+            this->building_ = std::make_shared<dravex::accessindex_t>();
+    }
+
+    return true;
+}
+
+/**
+ * Closes the reader.
+ */
+void dravex::entryreader::close(void)
+{
+    this->package_      = nullptr;
+    this->entry_        = nullptr;
+    this->index_        = -1;
+    this->input_offset_ = 0;
+    this->position_     = 0;
+    this->ended_        = false;
+    this->failed_       = false;
+    this->access_       = nullptr;
+    this->building_     = nullptr;
+    this->span_         = 0;
+
+    this->stream_.next_in  = nullptr;
+    this->stream_.avail_in = 0;
+}
+
+/**
+ * Reads the next data of the entry into the given buffer.
+ *
+ * @param {uint8_t*} output - The buffer to hold the data.
+ * @param {std::size_t} size - The number of bytes to read.
+ * @return {std::size_t} The number of bytes read. (Less than requested at the end of the entry or on failure.)
+ */
+std::size_t dravex::entryreader::read(uint8_t* output, const std::size_t size)
+{
+    if (this->entry_ == nullptr || this->failed_ || this->is_eof())
+        return 0;
+
+    // Read uncompressed data straight from the package..
+    if (!this->entry_->is_compressed_)
+    {
+        const auto count = static_cast<uint32_t>(std::min<uint64_t>(size, this->entry_->size_uncompressed_ - this->position_));
+        const auto bytes = this->package_->read_entry_raw(this->index_, static_cast<uint32_t>(this->position_), output, count);
+        if (bytes != count)
+            this->failed_ = true;
+
+        this->position_ += bytes;
+        return bytes;
+    }
+
+    dravex::scopedtimer timer{dravex::stage::inflate};
+
+    std::size_t done = 0;
+    while (done < size)
+    {
+        // Read the next chunk of compressed input..
+        if (this->stream_.avail_in == 0)
+        {
+            const auto bytes = this->package_->read_entry_raw(this->index_, this->input_offset_, this->input_.data(), static_cast<uint32_t>(this->input_.size()));
+            if (bytes == 0)
+            {
+                // The input ended before the stream did..
+                this->failed_ = true;
+                break;
+            }
+
+            this->input_offset_ += bytes;
+
+            this->stream_.next_in  = this->input_.data();
+            this->stream_.avail_in = bytes;
+        }
+
+        // Inflate the input into the callers buffer..
+        const auto avail        = static_cast<uInt>(std::min<std::size_t>(size - done, 0x40000000));
+        this->stream_.next_out  = output + done;
+        this->stream_.avail_out = avail;
+
+        // Stop at each deflate block boundary while recording access points..
+        const auto ret      = ::inflate(&this->stream_, this->building_ != nullptr ? Z_BLOCK : Z_NO_FLUSH);
+        const auto produced = avail - this->stream_.avail_out;
+
+        done            += produced;
+        this->position_ += produced;
+
+        if (ret == Z_STREAM_END)
+        {
+            this->ended_ = true;
+            break;
+        }
+
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[entryreader] failed to inflate compressed entry data, entry index: {}", this->index_);
+
+            this->failed_   = true;
+            this->building_ = nullptr;
+            break;
+        }
+
+        if (this->building_ != nullptr)
+            this->add_access_point();
+    }
+
+    // Keep the recorded access points within the package once the entry has been read in full..
+    if (this->building_ != nullptr && this->position_ == this->entry_->size_uncompressed_)
+    {
+        this->package_->set_access_index(this->index_, this->building_);
+        this->access_   = std::move(this->building_);
+        this->building_ = nullptr;
+    }
+
+    dravex::stats::instance().add(dravex::counter::bytes_inflated, done);
+    return done;
+}
+
+/**
+ * Skips over the next data of the entry.
+ *
+ * Compressed data is inflated into a small scratch buffer and discarded.
+ *
+ * @param {uint64_t} size - The number of bytes to skip.
+ * @return {uint64_t} The number of bytes skipped. (Less than requested at the end of the entry or on failure.)
+ */
+uint64_t dravex::entryreader::skip(const uint64_t size)
+{
+    if (this->entry_ == nullptr || this->failed_)
+        return 0;
+
+    if (!this->entry_->is_compressed_)
+    {
+        const auto count = std::min<uint64_t>(size, this->entry_->size_uncompressed_ - this->position_);
+        this->position_ += count;
+        return count;
+    }
+
+    std::array<uint8_t, 16 * 1024> scratch{};
+
+    uint64_t done = 0;
+    while (done < size)
+    {
+        const auto bytes = this->read(scratch.data(), static_cast<std::size_t>(std::min<uint64_t>(size - done, scratch.size())));
+        if (bytes == 0)
+            break;
+
+        done += bytes;
+    }
+
+    return done;
+}
+
+/**
+ * Moves the reader to the given offset within the uncompressed entry data.
+ *
+ * Compressed entries inflate forward from the current position, or from the closest access point before
+ * the offset when that is closer, and otherwise from the start of the entry.
+ *
+ * @param {uint64_t} offset - The offset to move to.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::entryreader::seek(const uint64_t offset)
+{
+    if (this->entry_ == nullptr || offset > this->entry_->size_uncompressed_)
+        return false;
+
+    if (!this->entry_->is_compressed_)
+    {
+        this->position_ = offset;
+        this->failed_   = false;
+        return true;
+    }
+
+    // Find the closest access point before the offset..
+    const dravex::accesspoint_t* point = nullptr;
+    if (this->access_ != nullptr)
+    {
+        const auto& points = this->access_->points_;
+        const auto iter    = std::upper_bound(points.begin(), points.end(), offset, [](const uint64_t value, const dravex::accesspoint_t& p) {
+            return value < p.output_;
+        });
+
+        if (iter != points.begin())
+            point = &*std::prev(iter);
+    }
+
+    // Inflate forward from the current position when it is the closest..
+    if (offset < this->position_ || this->failed_ || (point != nullptr && point->output_ > this->position_))
+    {
+        dravex::tracespan span{"entryreader::seek", "package", this->index_};
+
+        if (!this->resume(point))
+        {
+            this->failed_ = true;
+            return false;
+        }
+    }
+
+    const auto count = offset - this->position_;
+    return this->skip(count) == count;
+}
+
+/**
+ * Records an access point when the stream is at a deflate block boundary, spaced at least a span apart.
+ */
+void dravex::entryreader::add_access_point(void)
+{
+    // Bit 7 of data_type marks the end of a block, bit 6 the end of the last block..
+    if ((this->stream_.data_type & 128) == 0 || (this->stream_.data_type & 64) != 0)
+        return;
+
+    const auto last = this->building_->points_.empty() ? 0 : this->building_->points_.back().output_;
+    if (this->position_ - last < this->span_)
+        return;
+
+    dravex::accesspoint_t point{};
+    point.output_ = this->position_;
+    point.input_  = this->input_offset_ - this->stream_.avail_in;
+    point.bits_   = static_cast<uint32_t>(this->stream_.data_type & 7);
+
+    // Keep the window of output preceding the access point..
+    uInt size = 32768;
+    point.window_.resize(size);
+    if (inflateGetDictionary(&this->stream_, point.window_.data(), &size) != Z_OK)
+        return;
+    point.window_.resize(size);
+
+    this->building_->size_ += sizeof(point) + size;
+    this->building_->points_.push_back(std::move(point));
+}
+
+/**
+ * Resets the inflate stream to the given access point, or to the start of the entry.
+ *
+ * Repositioning abandons recording access points; the entry was not read in full from its start.
+ *
+ * @param {dravex::accesspoint_t*} point - The access point to resume at. (nullptr for the start of the entry.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::entryreader::resume(const dravex::accesspoint_t* point)
+{
+    this->building_        = nullptr;
+    this->ended_           = false;
+    this->failed_          = false;
+    this->stream_.next_in  = nullptr;
+    this->stream_.avail_in = 0;
+
+    if (point == nullptr)
+    {
+        this->input_offset_ = 0;
+        this->position_     = 0;
+
+        return inflateReset2(&this->stream_, MAX_WBITS) == Z_OK;
+    }
+
+    // The access point is within the deflate data; resume it as a raw stream..
+    if (inflateReset2(&this->stream_, -MAX_WBITS) != Z_OK)
+        return false;
+
+    // Feed the bits of the byte before the access point that are part of it..
+    if (point->bits_ != 0)
+    {
+        uint8_t value = 0;
+        if (this->package_->read_entry_raw(this->index_, point->input_ - 1, &value, 1) != 1)
+            return false;
+
+        if (inflatePrime(&this->stream_, static_cast<int>(point->bits_), value >> (8 - point->bits_)) != Z_OK)
+            return false;
+    }
+
+    if (inflateSetDictionary(&this->stream_, point->window_.data(), static_cast<uInt>(point->window_.size())) != Z_OK)
+        return false;
+
+    this->input_offset_ = point->input_;
+    this->position_     = point->output_;
+
+    return true;
+}
+
+/**
+ * Returns if the reader is open.
+ *
+ * @return {bool} True if open, false otherwise.
+ */
+bool dravex::entryreader::is_open(void) const
+{
+    return this->entry_ != nullptr;
+}
+
+/**
+ * Returns if all data of the entry has been read.
+ *
+ * @return {bool} True if at the end of the entry, false otherwise.
+ */
+bool dravex::entryreader::is_eof(void) const
+{
+    return this->entry_ == nullptr || this->ended_ || this->position_ >= this->entry_->size_uncompressed_;
+}
+
+/**
+ * Returns if reading the entry failed. (ie. the stored data is truncated or corrupt.)
+ *
+ * @return {bool} True if failed, false otherwise.
+ */
+bool dravex::entryreader::has_failed(void) const
+{
+    return this->failed_;
+}
+
+/**
+ * Returns the uncompressed size of the entry.
+ *
+ * @return {uint64_t} The entry size.
+ */
+uint64_t dravex::entryreader::get_size(void) const
+{
+    return this->entry_ == nullptr ? 0 : this->entry_->size_uncompressed_;
+}
+
+/**
+ * Returns the current position within the uncompressed entry data.
+ *
+ * @return {uint64_t} The position.
+ */
+uint64_t dravex::entryreader::get_position(void) const
+{
+    return this->position_;
+}
+
+/**
+ * Returns if access points are available for the entry.
+ *
+ * @return {bool} True if available, false otherwise.
+ */
+bool dravex::entryreader::has_access_index(void) const
+{
+    return this->access_ != nullptr;
+}
@@ -0,0 +1,102 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_ENTRYREADER_HPP
+#define PACKAGE_ENTRYREADER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "package.hpp"
+#include "zlib.h"
+
+namespace dravex
+{
+    /**
+     * Streaming reader over the data of a single package entry.
+     *
+     * Compressed entries are inflated a chunk at a time as they are read, so reading an entry of any size only
+     * needs the fixed input buffer and the zlib window; the memory used does not grow with the entry size.
+     * Readers are owned by a single thread and the package must outlive the reader.
+     *
+     * When the package has an access span set, reading a large compressed entry in full from its start also
+     * records access points at deflate block boundaries, in the manner of zlib's zran example, unless the
+     * reader was opened without recording. The package keeps them within its access budget, and later seeks
+     * into the entry, from any reader, resume inflating from the closest access point before the offset
+     * instead of from the start of the entry.
+     */
+    class entryreader final
+    {
+        entryreader(entryreader const&)            = delete;
+        entryreader(entryreader&&)                 = delete;
+        entryreader& operator=(entryreader const&) = delete;
+        entryreader& operator=(entryreader&&)      = delete;
+
+        dravex::package* package_;
+        const dravex::fileentry_t* entry_;
+        int32_t index_;
+
+        z_stream stream_;
+        bool stream_ready_;
+        std::vector<uint8_t> input_;
+        uint32_t input_offset_; // Offset of the next stored data to read..
+        uint64_t position_;
+        bool ended_;
+        bool failed_;
+
+        dravex::accessindexptr_t access_;                // Access points of the entry, when built..
+        std::shared_ptr<dravex::accessindex_t> building_; // Access points being recorded by a full read..
+        uint32_t span_;
+
+        auto add_access_point(void) -> void;
+        auto resume(const dravex::accesspoint_t* point) -> bool;
+
+    public:
+        static constexpr std::size_t chunk_size = 64 * 1024;
+
+        entryreader(void);
+        ~entryreader(void);
+
+        auto open(dravex::package* pkg, const int32_t index, const bool record = true) -> bool;
+        auto close(void) -> void;
+
+        auto read(uint8_t* output, const std::size_t size) -> std::size_t;
+        auto skip(const uint64_t size) -> uint64_t;
+        auto seek(const uint64_t offset) -> bool;
+
+        auto is_open(void) const -> bool;
+        auto is_eof(void) const -> bool;
+        auto has_failed(void) const -> bool;
+        auto get_size(void) const -> uint64_t;
+        auto get_position(void) const -> uint64_t;
+        auto has_access_index(void) const -> bool;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_ENTRYREADER_HPP
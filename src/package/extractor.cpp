@@ -0,0 +1,823 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "extractor.hpp"
+#include "package.hpp"
+#include "../bufferpool.hpp"
+#include "../logging.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
+#include "../utils.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::extractor::extractor(void)
+    : package_{nullptr}
+    , overlay_{nullptr}
+    , next_{0}
+    , completed_{0}
+    , bytes_written_{0}
+    , link_failures_{0}
+    , skipped_{0}
+    , streamed_{0}
+    , write_calls_{0}
+    , zerocopy_bytes_{0}
+    , cloned_bytes_{0}
+    , cancel_{false}
+    , total_{0}
+    , next_dir_{0}
+    , dirs_ready_{nullptr}
+{}
+dravex::extractor::~extractor(void)
+{
+    this->cancel();
+    this->wait();
+}
+
+/**
+ * Extraction worker thread; pulls the next entry index until all entries are handled.
+ */
+void dravex::extractor::worker(void)
+{
+    std::vector<int32_t> failed_index;
+    std::vector<std::filesystem::path> failed_paths;
+    std::vector<dravex::dedupentry_t> digests;
+    std::vector<dravex::incremententry_t> current;
+
+    dravex::tracing::instance().set_thread_name("extract worker");
+
+    const auto root        = this->options_.root_.string();
+    const auto dedup       = !this->options_.store_.empty() && !this->options_.discard_;
+    const auto incremental = this->options_.incremental_ && !this->options_.discard_;
+    const auto recording   = this->manifest_.is_open();
+    std::string fpath;
+    std::string name;
+    std::string digest;
+    bool lowered = false;
+
+    dravex::filewriter writer{this->options_.backend_};
+    dravex::entryreader reader;
+
+    // Records an extracted entry within the extraction and incremental manifests..
+    const auto emit = [&](const int32_t index, const int32_t local, const dravex::fileentry_t* entry, const std::string_view rel, const std::string_view output, const std::string_view digest, const uint32_t adler, uint16_t flags) {
+        if (recording)
+        {
+            if (entry->is_compressed_)
+                flags |= dravex::manifest_flag_compressed;
+
+            const auto layer = this->overlay_ != nullptr ? this->overlay_->get_entry_layer(index) : 0;
+            this->manifest_.write({rel, output, static_cast<uint32_t>(local), layer, entry->file_type_, entry->data_offset_, entry->size_compressed_, entry->size_uncompressed_, adler, flags});
+        }
+
+        if (incremental)
+            current.push_back({std::string{rel}, std::string{digest}, adler, entry->size_uncompressed_, entry->checksum_});
+    };
+
+    // Records the current entry..
+    const auto record = [&](const int32_t index, const int32_t local, const dravex::fileentry_t* entry, const std::string_view output, const uint32_t adler, const uint16_t flags) {
+        emit(index, local, entry, std::string_view{fpath}.substr(root.size() + 1), output, digest, adler, flags);
+    };
+
+    // Entries whose writes are queued by the writer; recorded once their writes complete..
+    std::vector<queuedentry_t> queued;
+    std::size_t failures = 0;
+
+    const auto complete = [&](void) {
+        if (writer.get_queued() != 0)
+            return;
+
+        // Skip the entries whose writes failed since the last completion..
+        const auto& failed = writer.get_failed();
+        for (const auto& q : queued)
+        {
+            if (std::find(failed.begin() + failures, failed.end(), q.path_) != failed.end())
+                continue;
+
+            emit(q.index_, q.local_, q.entry_, std::string_view{q.path_}.substr(root.size() + 1), q.path_, q.digest_, q.adler_, 0);
+        }
+
+        queued.clear();
+        failures = failed.size();
+    };
+
+    // Create the output directories, shared with the other workers..
+    for (auto x = this->next_dir_++; x < this->dirs_.size() && !this->cancel_; x = this->next_dir_++)
+    {
+        dravex::scopedtimer timer{dravex::stage::mkdir};
+        dravex::tracespan phase{"mkdir", "extract", static_cast<int64_t>(x)};
+
+        std::error_code ec{};
+        std::filesystem::create_directories(this->dirs_[x], ec);
+    }
+
+    // Wait for all output directories to exist before writing..
+    this->dirs_ready_->arrive_and_wait();
+
+    for (auto index = this->next_++; index < this->total_ && !this->cancel_; index = this->next_++)
+    {
+        dravex::tracespan span{"extract", "extract", static_cast<int64_t>(index)};
+
+        // Obtain the asset entry information and the package holding it..
+        int32_t local    = 0;
+        const auto pkg   = this->resolve(static_cast<int32_t>(index), local);
+        const auto entry = pkg == nullptr ? nullptr : pkg->get_entry(local);
+        if (entry == nullptr)
+        {
+            failed_index.push_back(static_cast<int32_t>(index));
+            this->completed_++;
+            continue;
+        }
+
+        // Lower the memory priority of the data read from packages that are streamed in a single pass..
+        if (!lowered && pkg->get_access_pattern() == dravex::accesspattern::sequential)
+        {
+            dravex::utils::set_memory_priority(true);
+            lowered = true;
+        }
+
+        const auto has_name = pkg->get_entry_name(local, name);
+        const auto ext      = dravex::package::get_extension(entry->file_type_);
+
+        // Prepare the full path to the file.. (Reuses the path buffer to avoid allocating per entry.)
+        if (this->options_.discard_)
+            fpath.assign("NUL");
+        else
+        {
+            fpath.assign(root);
+            fpath.append(1, static_cast<char>(std::filesystem::path::preferred_separator));
+            fpath.append(has_name ? std::string_view{name} : std::string_view{"(unknown)"});
+            fpath.append(ext);
+        }
+
+        digest.clear();
+
+        // Skip the entry if its output matches the previous extraction.. (Checked without reading the entry.)
+        if (incremental)
+        {
+            const auto iter = this->previous_.find(fpath.substr(root.size() + 1));
+            if (iter != this->previous_.end() && iter->second.size_ == entry->size_uncompressed_ && iter->second.checksum_ == entry->checksum_ && (!dedup || !iter->second.digest_.empty()))
+            {
+                // Check the stored object instead when the paths are not linked to it..
+                const auto stored = dedup && !this->options_.links_;
+                const auto output = stored ? this->store_.get_object_path(iter->second.digest_) : fpath;
+
+                std::error_code ec{};
+                if (std::filesystem::file_size(output, ec) == entry->size_uncompressed_ && !ec)
+                {
+                    digest = iter->second.digest_;
+                    if (dedup)
+                        digests.push_back({digest, iter->first});
+
+                    record(static_cast<int32_t>(index), local, entry, output, iter->second.adler32_, static_cast<uint16_t>(dravex::manifest_flag_skipped | (stored ? dravex::manifest_flag_stored : 0)));
+
+                    this->skipped_++;
+                    this->completed_++;
+                    continue;
+                }
+            }
+        }
+
+        // View uncompressed entries within the mapped game.pkg file, otherwise read the entry data into a pooled buffer..
+        dravex::entryview_t view{};
+        const auto mapped = this->options_.zerocopy_ && pkg->get_entry_view(local, view);
+
+        // Stream large entries a chunk at a time.. (Deduplicating needs the whole content to hash it.)
+        if (!mapped && !dedup && this->options_.stream_size_ != 0 && entry->size_uncompressed_ >= this->options_.stream_size_)
+        {
+            dravex::tracespan phase{"stream", "extract"};
+
+            uint32_t adler = 0;
+            // Extraction reads each entry once; do not keep access points for it..
+            if (reader.open(pkg, local, false) && writer.write(fpath, reader, adler))
+            {
+                this->bytes_written_ += entry->size_uncompressed_;
+                dravex::stats::instance().add(dravex::counter::bytes_written, entry->size_uncompressed_);
+
+                if (!this->options_.discard_)
+                    record(static_cast<int32_t>(index), local, entry, fpath, adler, 0);
+            }
+            else
+                failed_paths.push_back(fpath);
+
+            reader.close();
+
+            this->streamed_++;
+            this->completed_++;
+            continue;
+        }
+
+        dravex::pooledbuffer data{writer.acquire(mapped ? 0 : entry->size_uncompressed_)};
+        if (!mapped && !pkg->read_entry(local, data.get()))
+        {
+            failed_index.push_back(static_cast<int32_t>(index));
+            this->completed_++;
+            continue;
+        }
+
+        const auto buffer = mapped ? view.data_ : data.get().data();
+        const auto size   = mapped ? static_cast<std::size_t>(view.size_) : data.get().size();
+        const auto adler  = recording || incremental ? dravex::utils::adler32(buffer, size) : 0;
+
+        // Put the asset content into the content store..
+        if (dedup)
+        {
+            const auto result = this->store_.put(buffer, size, digest);
+            if (mapped)
+                pkg->release_entry_view(view);
+
+            if (result == dravex::storeresult::failed)
+            {
+                failed_paths.push_back(fpath);
+                this->completed_++;
+                continue;
+            }
+
+            if (result == dravex::storeresult::stored)
+                this->bytes_written_ += size;
+
+            digests.push_back({digest, fpath.substr(root.size() + 1)});
+
+            // Only map the path to the object when links are not wanted..
+            if (!this->options_.links_)
+            {
+                record(static_cast<int32_t>(index), local, entry, this->store_.get_object_path(digest), adler, dravex::manifest_flag_stored);
+
+                this->completed_++;
+                continue;
+            }
+        }
+
+        // Link the path to the stored object.. (Falls back to writing a copy, ie. when the store is on another volume.)
+        if (dedup)
+        {
+            dravex::tracespan phase{"link", "extract"};
+
+            if (this->store_.link(digest, fpath))
+            {
+                record(static_cast<int32_t>(index), local, entry, fpath, adler, 0);
+
+                this->completed_++;
+                continue;
+            }
+
+            this->link_failures_++;
+        }
+
+        // Save the asset..
+        {
+            dravex::scopedtimer timer{dravex::stage::write};
+            dravex::tracespan phase{"write", "extract"};
+
+            const auto written = mapped ? writer.copy(fpath, view) : writer.write(fpath, data.get());
+            if (mapped)
+                pkg->release_entry_view(view);
+
+            if (written)
+            {
+                this->bytes_written_ += size;
+                dravex::stats::instance().add(dravex::counter::bytes_written, size);
+
+                // Queued writes are recorded once they complete..
+                if (!this->options_.discard_)
+                {
+                    if (!mapped && writer.get_backend() == dravex::writebackend::ioring)
+                        queued.push_back({static_cast<int32_t>(index), local, entry, fpath, digest, adler});
+                    else
+                        record(static_cast<int32_t>(index), local, entry, fpath, adler, 0);
+                }
+            }
+            else
+                failed_paths.push_back(fpath);
+
+            complete();
+        }
+
+        this->completed_++;
+    }
+
+    // Complete the queued writes..
+    writer.flush();
+    complete();
+    failed_paths.insert(failed_paths.end(), writer.get_failed().begin(), writer.get_failed().end());
+
+    this->write_calls_ += writer.get_calls();
+    dravex::stats::instance().add(dravex::counter::write_calls, writer.get_calls());
+
+    this->zerocopy_bytes_ += writer.get_copied();
+    this->cloned_bytes_   += writer.get_cloned();
+    dravex::stats::instance().add(dravex::counter::zerocopy_bytes, writer.get_copied());
+    dravex::stats::instance().add(dravex::counter::cloned_bytes, writer.get_cloned());
+
+    // Merge the failures and manifest entries of this worker..
+    std::lock_guard<std::mutex> lock{this->failed_mutex_};
+    this->failed_index_.insert(this->failed_index_.end(), failed_index.begin(), failed_index.end());
+    this->failed_paths_.insert(this->failed_paths_.end(), failed_paths.begin(), failed_paths.end());
+    this->digests_.insert(this->digests_.end(), std::make_move_iterator(digests.begin()), std::make_move_iterator(digests.end()));
+    this->current_.insert(this->current_.end(), std::make_move_iterator(current.begin()), std::make_move_iterator(current.end()));
+}
+
+/**
+ * Starts extracting all assets of the given package.
+ *
+ * @param {dravex::packageptr_t&} pkg - The package to extract. (Kept alive until the extraction has finished.)
+ * @param {extractoptions_t&} options - The extraction options.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::extractor::start(const dravex::packageptr_t& pkg, const dravex::extractoptions_t& options)
+{
+    this->cancel();
+    this->wait();
+
+    this->package_ = pkg;
+    this->overlay_ = nullptr;
+    this->options_ = options;
+    this->total_   = pkg == nullptr ? 0 : pkg->get_entry_count();
+
+    return this->begin();
+}
+
+/**
+ * Starts extracting all effective assets of the given overlay.
+ *
+ * @param {dravex::overlayptr_t&} view - The overlay to extract. (Kept alive until the extraction has finished.)
+ * @param {extractoptions_t&} options - The extraction options.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::extractor::start(const dravex::overlayptr_t& view, const dravex::extractoptions_t& options)
+{
+    this->cancel();
+    this->wait();
+
+    this->package_ = nullptr;
+    this->overlay_ = view;
+    this->options_ = options;
+    this->total_   = view == nullptr ? 0 : view->get_entry_count();
+
+    return this->begin();
+}
+
+/**
+ * Resolves the given entry index to the package and entry index to extract it from.
+ *
+ * @param {int32_t} index - The entry index being extracted.
+ * @param {int32_t&} local - The entry index within the returned package.
+ * @return {dravex::package*} The package on success, nullptr otherwise.
+ */
+dravex::package* dravex::extractor::resolve(const int32_t index, int32_t& local) const
+{
+    if (this->overlay_ != nullptr)
+        return this->overlay_->resolve(index, local);
+
+    local = index;
+    return this->package_.get();
+}
+
+/**
+ * Collects the unique output directories of the current extraction from the directory index of each package.
+ *
+ * Only the leaf directories are collected, as creating them also creates all of their parents.
+ */
+void dravex::extractor::collect_directories(void)
+{
+    std::vector<dravex::package*> packages;
+    if (this->overlay_ != nullptr)
+    {
+        for (uint32_t x = 0; x < this->overlay_->get_layer_count(); x++)
+            packages.push_back(this->overlay_->get_layer(x).get());
+    }
+    else
+        packages.push_back(this->package_.get());
+
+    const auto root = this->options_.root_.string();
+
+    for (const auto pkg : packages)
+    {
+        const auto count = static_cast<uint32_t>(pkg->get_directory_count());
+
+        // Skip the root directory; it was created with the extraction root..
+        for (uint32_t x = 1; x < count; x++)
+        {
+            if (pkg->get_directory(x)->first_child_ != dravex::invalid_index)
+                continue;
+
+            std::string path{root};
+            path.append(1, static_cast<char>(std::filesystem::path::preferred_separator));
+            path.append(pkg->get_directory_path(x));
+
+            this->dirs_.push_back(std::move(path));
+        }
+    }
+
+    // Remove the directories shared between the overlay layers..
+    if (packages.size() > 1)
+    {
+        std::sort(this->dirs_.begin(), this->dirs_.end());
+        this->dirs_.erase(std::unique(this->dirs_.begin(), this->dirs_.end()), this->dirs_.end());
+    }
+
+    DRAVEX_LOG(dravex::loglevel::debug, "[extractor] creating {} output directories.", this->dirs_.size());
+}
+
+/**
+ * Starts the worker threads for the current extraction.
+ *
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::extractor::begin(void)
+{
+    this->next_           = 0;
+    this->completed_      = 0;
+    this->bytes_written_  = 0;
+    this->link_failures_  = 0;
+    this->skipped_        = 0;
+    this->streamed_       = 0;
+    this->write_calls_    = 0;
+    this->zerocopy_bytes_ = 0;
+    this->cloned_bytes_   = 0;
+    this->cancel_         = false;
+    this->failed_index_.clear();
+    this->failed_paths_.clear();
+    this->digests_.clear();
+    this->previous_.clear();
+    this->current_.clear();
+    this->store_.close();
+    this->manifest_.close();
+
+    if (this->total_ == 0)
+        return false;
+
+    // Ensure the root path exists..
+    if (!this->options_.discard_)
+    {
+        std::error_code ec{};
+        if (!std::filesystem::exists(this->options_.root_, ec))
+            std::filesystem::create_directories(this->options_.root_, ec);
+    }
+
+    // Load the manifest of the previous extraction..
+    if (this->options_.incremental_ && !this->options_.discard_)
+        this->load_increments();
+
+    // Open the content store..
+    if (!this->options_.store_.empty() && !this->options_.discard_ && !this->store_.open(this->options_.store_))
+        return false;
+
+    // Open the extraction manifest..
+    if ((!this->options_.manifest_json_.empty() || !this->options_.manifest_binary_.empty()) && !this->options_.discard_)
+    {
+        if (!this->manifest_.open(this->options_.manifest_json_, this->options_.manifest_binary_))
+        {
+            this->manifest_.close();
+            return false;
+        }
+    }
+
+    // Collect the output directories, created by the workers before writing..
+    this->dirs_.clear();
+    this->next_dir_ = 0;
+
+    if (!this->options_.discard_ && (this->options_.store_.empty() || this->options_.links_))
+        this->collect_directories();
+
+    // Start the worker threads..
+    const auto count = std::clamp<uint32_t>(this->options_.threads_, 1, 64);
+    this->dirs_ready_ = std::make_unique<std::latch>(count);
+
+    for (uint32_t x = 0; x < count; x++)
+        this->workers_.emplace_back(&dravex::extractor::worker, this);
+
+    return true;
+}
+
+/**
+ * Saves the deduplication manifest, mapping each extracted path to the digest of its stored object.
+ *
+ * The manifest is written to the extraction root in the sha256sum format, sorted by path, so the linked
+ * files can be checked with 'sha256sum -c'.
+ *
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::extractor::save_digests(void)
+{
+    std::sort(this->digests_.begin(), this->digests_.end(), [](const dravex::dedupentry_t& a, const dravex::dedupentry_t& b) {
+        return a.path_ < b.path_;
+    });
+
+    std::ofstream f{this->get_digests_path(), std::ios::binary | std::ios::trunc};
+    if (!f.is_open())
+    {
+        DRAVEX_LOG(dravex::loglevel::error, "[extractor] failed to save the deduplication manifest: {}", this->get_digests_path().string());
+        return false;
+    }
+
+    for (const auto& e : this->digests_)
+        f << e.digest_ << " *" << e.path_ << "\n";
+
+    return f.good();
+}
+
+/**
+ * Loads the incremental manifest of the previous extraction into the output directory.
+ *
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::extractor::load_increments(void)
+{
+    std::ifstream f{this->get_increments_path(), std::ios::binary};
+    if (!f.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(f, line))
+    {
+        // Each line holds: <checksum>\t<size>\t<adler32>\t<digest or ->\t<path>
+        std::array<std::size_t, 4> tabs{};
+
+        auto pos = line.find('\t');
+        for (auto& t : tabs)
+        {
+            t   = pos;
+            pos = pos == std::string::npos ? pos : line.find('\t', pos + 1);
+        }
+
+        if (tabs[3] == std::string::npos || tabs[3] + 1 == line.size())
+            continue;
+
+        dravex::incremententry_t e{};
+        e.checksum_ = static_cast<uint32_t>(std::strtoul(line.c_str(), nullptr, 16));
+        e.size_     = static_cast<uint32_t>(std::strtoul(line.c_str() + tabs[0] + 1, nullptr, 10));
+        e.adler32_  = static_cast<uint32_t>(std::strtoul(line.c_str() + tabs[1] + 1, nullptr, 16));
+        e.digest_   = line.substr(tabs[2] + 1, tabs[3] - tabs[2] - 1);
+        e.path_     = line.substr(tabs[3] + 1);
+
+        if (e.digest_ == "-")
+            e.digest_.clear();
+
+        auto key = e.path_;
+        this->previous_.insert_or_assign(std::move(key), std::move(e));
+    }
+
+    DRAVEX_LOG(dravex::loglevel::info, "[extractor] loaded {} incremental manifest entries.", this->previous_.size());
+    return true;
+}
+
+/**
+ * Saves the incremental manifest, holding the size and checksum of each path that is up to date.
+ *
+ * Entries that failed to extract are left out, so they are extracted again by the next incremental extraction.
+ *
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::extractor::save_increments(void)
+{
+    std::sort(this->current_.begin(), this->current_.end(), [](const dravex::incremententry_t& a, const dravex::incremententry_t& b) {
+        return a.path_ < b.path_;
+    });
+
+    // Write the manifest under a temporary name, so a failed save keeps the previous manifest..
+    const auto path = this->get_increments_path();
+    auto temp       = path;
+    temp += ".part";
+
+    {
+        std::ofstream f{temp, std::ios::binary | std::ios::trunc};
+        if (!f.is_open())
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[extractor] failed to save the incremental manifest: {}", path.string());
+            return false;
+        }
+
+        for (const auto& e : this->current_)
+            f << std::format("{:08x}\t{}\t{:08x}\t{}\t{}\n", e.checksum_, e.size_, e.adler32_, e.digest_.empty() ? "-" : e.digest_, e.path_);
+
+        if (!f.good())
+            return false;
+    }
+
+    std::error_code ec{};
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+
+/**
+ * Requests that the current extraction stops as soon as possible.
+ */
+void dravex::extractor::cancel(void)
+{
+    this->cancel_ = true;
+}
+
+/**
+ * Waits for the current extraction to finish.
+ */
+void dravex::extractor::wait(void)
+{
+    const auto running = !this->workers_.empty();
+
+    for (auto& t : this->workers_)
+    {
+        if (t.joinable())
+            t.join();
+    }
+
+    // Flush the extraction manifest..
+    if (running)
+        this->manifest_.close();
+
+    // Save the deduplication manifest of the finished extraction..
+    if (running && !this->store_.get_root().empty())
+        this->save_digests();
+
+    // Save the incremental manifest of the finished extraction..
+    if (running && this->options_.incremental_ && !this->options_.discard_)
+        this->save_increments();
+
+    this->workers_.clear();
+    this->package_ = nullptr;
+    this->overlay_ = nullptr;
+}
+
+/**
+ * Returns if the extractor is currently extracting assets.
+ *
+ * @return {bool} True if running, false otherwise.
+ */
+bool dravex::extractor::is_running(void) const
+{
+    return !this->workers_.empty() && this->completed_ < this->total_ && !this->cancel_;
+}
+
+/**
+ * Returns the total number of entries being extracted.
+ *
+ * @return {std::size_t} The total entry count.
+ */
+std::size_t dravex::extractor::get_total(void) const
+{
+    return this->total_;
+}
+
+/**
+ * Returns the number of entries that have been handled.
+ *
+ * @return {std::size_t} The handled entry count.
+ */
+std::size_t dravex::extractor::get_completed(void) const
+{
+    return this->completed_;
+}
+
+/**
+ * Returns the number of bytes that have been written.
+ *
+ * @return {uint64_t} The written byte count.
+ */
+uint64_t dravex::extractor::get_bytes_written(void) const
+{
+    return this->bytes_written_;
+}
+
+/**
+ * Returns the entry indexes that failed to extract. (Only valid once the extraction has finished.)
+ *
+ * @return {std::vector&} The failed entry indexes.
+ */
+const std::vector<int32_t>& dravex::extractor::get_failed_index(void) const
+{
+    return this->failed_index_;
+}
+
+/**
+ * Returns the output paths that failed to be written. (Only valid once the extraction has finished.)
+ *
+ * @return {std::vector&} The failed output paths.
+ */
+const std::vector<std::filesystem::path>& dravex::extractor::get_failed_paths(void) const
+{
+    return this->failed_paths_;
+}
+
+/**
+ * Returns the number of paths that could not be linked to their stored object and were written instead.
+ *
+ * @return {uint64_t} The link failure count.
+ */
+uint64_t dravex::extractor::get_link_failures(void) const
+{
+    return this->link_failures_;
+}
+
+/**
+ * Returns the content store of the current extraction. (Only open when the extraction deduplicates.)
+ *
+ * @return {dravex::contentstore&} The content store.
+ */
+const dravex::contentstore& dravex::extractor::get_store(void) const
+{
+    return this->store_;
+}
+
+/**
+ * Returns the number of records written to the extraction manifest.
+ *
+ * @return {uint64_t} The record count.
+ */
+uint64_t dravex::extractor::get_manifest_count(void) const
+{
+    return this->manifest_.get_count();
+}
+
+/**
+ * Returns the path of the deduplication manifest of the current extraction.
+ *
+ * @return {std::filesystem::path} The manifest path.
+ */
+std::filesystem::path dravex::extractor::get_digests_path(void) const
+{
+    return this->options_.root_ / "dedup.sha256";
+}
+
+/**
+ * Returns the number of entries skipped, as their output matched the previous extraction.
+ *
+ * @return {std::size_t} The skipped entry count.
+ */
+std::size_t dravex::extractor::get_skipped(void) const
+{
+    return this->skipped_;
+}
+
+/**
+ * Returns the number of file API calls made to write the extracted files.
+ *
+ * @return {uint64_t} The call count.
+ */
+uint64_t dravex::extractor::get_write_calls(void) const
+{
+    return this->write_calls_;
+}
+
+/**
+ * Returns the path of the incremental manifest of the current extraction.
+ *
+ * @return {std::filesystem::path} The manifest path.
+ */
+std::filesystem::path dravex::extractor::get_increments_path(void) const
+{
+    return this->options_.root_ / "incremental.manifest";
+}
+
+/**
+ * Returns the number of uncompressed entry bytes copied straight from the mapped game.pkg file.
+ *
+ * @return {uint64_t} The zero-copy byte count. (Includes the cloned bytes.)
+ */
+uint64_t dravex::extractor::get_zerocopy_bytes(void) const
+{
+    return this->zerocopy_bytes_;
+}
+
+/**
+ * Returns the number of uncompressed entry bytes cloned from the game.pkg file.
+ *
+ * @return {uint64_t} The cloned byte count.
+ */
+uint64_t dravex::extractor::get_cloned_bytes(void) const
+{
+    return this->cloned_bytes_;
+}
+
+/**
+ * Returns the number of entries that were streamed a chunk at a time.
+ *
+ * @return {std::size_t} The streamed entry count.
+ */
+std::size_t dravex::extractor::get_streamed(void) const
+{
+    return this->streamed_;
+}
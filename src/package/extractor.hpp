@@ -0,0 +1,184 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PACKAGE_EXTRACTOR_HPP
+#define PACKAGE_EXTRACTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "contentstore.hpp"
+#include "filewriter.hpp"
+#include "manifest.hpp"
+#include "overlay.hpp"
+#include "package.hpp"
+
+namespace dravex
+{
+    /**
+     * Structure definition for the options used when extracting all assets.
+     */
+    struct extractoptions_t
+    {
+        std::filesystem::path root_;
+        std::filesystem::path store_;           // Content store directory; deduplicates the extracted content when set..
+        std::filesystem::path manifest_json_;   // Extraction manifest written as JSON lines, when set..
+        std::filesystem::path manifest_binary_; // Extraction manifest written in the binary form, when set..
+        uint32_t threads_;
+        uint64_t stream_size_; // Entries at least this large are streamed a chunk at a time, bounding the memory used; 0 to disable..
+        dravex::writebackend backend_;
+        bool discard_;
+        bool links_;       // Hard links each path to its stored object; otherwise only the manifest maps the paths..
+        bool incremental_; // Skips the entries whose output matches the previous extraction..
+        bool zerocopy_;    // Copies uncompressed entries straight from the mapped game.pkg file..
+
+        extractoptions_t(void)
+            : root_{}
+            , store_{}
+            , manifest_json_{}
+            , manifest_binary_{}
+            , threads_{1}
+            , stream_size_{0}
+            , backend_{dravex::writebackend::stdio}
+            , discard_{false}
+            , links_{true}
+            , incremental_{false}
+            , zerocopy_{true}
+        {}
+    };
+
+    /**
+     * Structure definition for an entry of the deduplication manifest.
+     */
+    struct dedupentry_t
+    {
+        std::string digest_;
+        std::string path_;
+    };
+
+    /**
+     * Structure definition for an entry of the incremental extraction manifest.
+     */
+    struct incremententry_t
+    {
+        std::string path_;
+        std::string digest_; // Digest of the stored object, when the extraction deduplicated..
+        uint32_t adler32_;
+        uint32_t size_;
+        uint32_t checksum_;
+    };
+
+    /**
+     * Structure definition for an extracted entry whose write is queued, recorded once the write completes.
+     */
+    struct queuedentry_t
+    {
+        int32_t index_;
+        int32_t local_;
+        const dravex::fileentry_t* entry_;
+        std::string path_;
+        std::string digest_;
+        uint32_t adler_;
+    };
+
+    class extractor final
+    {
+        extractor(extractor const&)            = delete;
+        extractor(extractor&&)                 = delete;
+        extractor& operator=(extractor const&) = delete;
+        extractor& operator=(extractor&&)      = delete;
+
+        dravex::packageptr_t package_;
+        dravex::overlayptr_t overlay_;
+        extractoptions_t options_;
+        std::vector<std::thread> workers_;
+        std::atomic<std::size_t> next_;
+        std::atomic<std::size_t> completed_;
+        std::atomic<uint64_t> bytes_written_;
+        std::atomic<uint64_t> link_failures_;
+        std::atomic<std::size_t> skipped_;
+        std::atomic<std::size_t> streamed_;
+        std::atomic<uint64_t> write_calls_;
+        std::atomic<uint64_t> zerocopy_bytes_;
+        std::atomic<uint64_t> cloned_bytes_;
+        std::atomic<bool> cancel_;
+        std::size_t total_;
+
+        std::vector<std::string> dirs_;
+        std::atomic<std::size_t> next_dir_;
+        std::unique_ptr<std::latch> dirs_ready_;
+
+        std::mutex failed_mutex_;
+        std::vector<int32_t> failed_index_;
+        std::vector<std::filesystem::path> failed_paths_;
+        std::vector<dravex::dedupentry_t> digests_;
+        std::unordered_map<std::string, dravex::incremententry_t> previous_;
+        std::vector<dravex::incremententry_t> current_;
+
+        dravex::contentstore store_;
+        dravex::manifestwriter manifest_;
+
+        void worker(void);
+        auto resolve(const int32_t index, int32_t& local) const -> dravex::package*;
+        auto begin(void) -> bool;
+        auto collect_directories(void) -> void;
+        auto save_digests(void) -> bool;
+        auto load_increments(void) -> bool;
+        auto save_increments(void) -> bool;
+
+    public:
+        extractor(void);
+        ~extractor(void);
+
+        auto start(const dravex::packageptr_t& pkg, const extractoptions_t& options) -> bool;
+        auto start(const dravex::overlayptr_t& view, const extractoptions_t& options) -> bool;
+        auto cancel(void) -> void;
+        auto wait(void) -> void;
+
+        auto is_running(void) const -> bool;
+        auto get_total(void) const -> std::size_t;
+        auto get_completed(void) const -> std::size_t;
+        auto get_bytes_written(void) const -> uint64_t;
+        auto get_skipped(void) const -> std::size_t;
+        auto get_streamed(void) const -> std::size_t;
+        auto get_write_calls(void) const -> uint64_t;
+        auto get_zerocopy_bytes(void) const -> uint64_t;
+        auto get_cloned_bytes(void) const -> uint64_t;
+        auto get_failed_index(void) const -> const std::vector<int32_t>&;
+        auto get_failed_paths(void) const -> const std::vector<std::filesystem::path>&;
+        auto get_link_failures(void) const -> uint64_t;
+        auto get_store(void) const -> const dravex::contentstore&;
+        auto get_manifest_count(void) const -> uint64_t;
+        auto get_digests_path(void) const -> std::filesystem::path;
+        auto get_increments_path(void) const -> std::filesystem::path;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_EXTRACTOR_HPP
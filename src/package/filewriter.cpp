@@ -0,0 +1,709 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "filewriter.hpp"
+#include "../bufferpool.hpp"
+#include "../logging.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
+
+namespace
+{
+    /**
+     * I/O ring definitions. (Mirrors ioringapi.h of the Windows 11 22H2 SDK, so older SDKs can build.)
+     */
+    struct ioringflags_t
+    {
+        uint32_t required_;
+        uint32_t advisory_;
+    };
+
+    struct ioringref_t
+    {
+        uint32_t kind_; // IORING_REF_RAW (0)
+        union
+        {
+            HANDLE handle_;
+            void* address_;
+        };
+    };
+
+    struct ioringcqe_t
+    {
+        ULONG_PTR user_data_;
+        HRESULT result_;
+        ULONG_PTR information_;
+    };
+
+    constexpr uint32_t ioring_version_3  = 300; // First version supporting writes..
+    constexpr uint32_t ioring_op_write   = 5;
+    constexpr uint32_t ioring_ref_raw    = 0;
+    constexpr HRESULT ioring_cqe_popped  = 0; // S_OK; S_FALSE once the completion queue is empty..
+    constexpr uint32_t ioring_wait_never = 0xFFFFFFFF;
+
+    /**
+     * Block cloning definitions. (Mirrors winioctl.h, so older SDKs can build.)
+     */
+    struct duplicateextents_t
+    {
+        HANDLE file_;
+        LARGE_INTEGER source_offset_;
+        LARGE_INTEGER target_offset_;
+        LARGE_INTEGER byte_count_;
+    };
+
+    struct integrityinfo_t
+    {
+        uint16_t checksum_algorithm_;
+        uint16_t reserved_;
+        uint32_t flags_;
+        uint32_t checksum_chunk_size_;
+        uint32_t cluster_size_;
+    };
+
+    /**
+     * Direct backend definitions. (4096 bytes covers the sector sizes of both 512e and 4Kn disks.)
+     */
+    constexpr std::size_t direct_alignment = 4096;
+    constexpr std::size_t direct_chunk     = 1024 * 1024;
+
+    /**
+     * The chunk size used to write streamed entries with the stdio backend.
+     */
+    constexpr std::size_t stream_chunk = 1024 * 1024;
+
+    constexpr DWORD fsctl_duplicate_extents_to_file = 0x00098344;
+    constexpr DWORD fsctl_get_integrity_information = 0x0009027C; // Only supported by volumes that can clone blocks..
+
+    using CreateIoRing_t         = HRESULT(WINAPI*)(uint32_t, ioringflags_t, uint32_t, uint32_t, void**);
+    using IsIoRingOpSupported_t  = BOOL(WINAPI*)(void*, uint32_t);
+    using BuildIoRingWriteFile_t = HRESULT(WINAPI*)(void*, ioringref_t, ioringref_t, uint32_t, uint64_t, uint32_t, ULONG_PTR, uint32_t);
+    using SubmitIoRing_t         = HRESULT(WINAPI*)(void*, uint32_t, uint32_t, uint32_t*);
+    using PopIoRingCompletion_t  = HRESULT(WINAPI*)(void*, ioringcqe_t*);
+    using CloseIoRing_t          = HRESULT(WINAPI*)(void*);
+
+    /**
+     * Structure definition for the I/O ring functions, resolved at runtime.
+     */
+    struct ioringapi_t
+    {
+        CreateIoRing_t create_;
+        IsIoRingOpSupported_t is_op_supported_;
+        BuildIoRingWriteFile_t build_write_;
+        SubmitIoRing_t submit_;
+        PopIoRingCompletion_t pop_completion_;
+        CloseIoRing_t close_;
+        bool ready_;
+
+        ioringapi_t(void)
+            : create_{nullptr}
+            , is_op_supported_{nullptr}
+            , build_write_{nullptr}
+            , submit_{nullptr}
+            , pop_completion_{nullptr}
+            , close_{nullptr}
+            , ready_{false}
+        {
+            const auto mod = ::GetModuleHandleA("KernelBase.dll");
+            if (mod == nullptr)
+                return;
+
+            this->create_          = reinterpret_cast<CreateIoRing_t>(::GetProcAddress(mod, "CreateIoRing"));
+            this->is_op_supported_ = reinterpret_cast<IsIoRingOpSupported_t>(::GetProcAddress(mod, "IsIoRingOpSupported"));
+            this->build_write_     = reinterpret_cast<BuildIoRingWriteFile_t>(::GetProcAddress(mod, "BuildIoRingWriteFile"));
+            this->submit_          = reinterpret_cast<SubmitIoRing_t>(::GetProcAddress(mod, "SubmitIoRing"));
+            this->pop_completion_  = reinterpret_cast<PopIoRingCompletion_t>(::GetProcAddress(mod, "PopIoRingCompletion"));
+            this->close_           = reinterpret_cast<CloseIoRing_t>(::GetProcAddress(mod, "CloseIoRing"));
+
+            this->ready_ = this->create_ != nullptr && this->is_op_supported_ != nullptr && this->build_write_ != nullptr &&
+                           this->submit_ != nullptr && this->pop_completion_ != nullptr && this->close_ != nullptr;
+        }
+    };
+
+    /**
+     * Returns the I/O ring functions.
+     *
+     * @return {ioringapi_t&} The I/O ring functions.
+     */
+    const ioringapi_t& get_ioring_api(void)
+    {
+        static const ioringapi_t api;
+        return api;
+    }
+
+    /**
+     * Creates an I/O ring that supports writes.
+     *
+     * @param {uint32_t} size - The submission queue size.
+     * @return {void*} The I/O ring on success, nullptr otherwise.
+     */
+    void* create_ioring(const uint32_t size)
+    {
+        const auto& api = get_ioring_api();
+        if (!api.ready_)
+            return nullptr;
+
+        void* ring = nullptr;
+        if (FAILED(api.create_(ioring_version_3, ioringflags_t{0, 0}, size, size * 2, &ring)))
+            return nullptr;
+
+        if (!api.is_op_supported_(ring, ioring_op_write))
+        {
+            api.close_(ring);
+            return nullptr;
+        }
+
+        return ring;
+    }
+
+} // namespace
+
+/**
+ * Constructor and Destructor
+ *
+ * @param {dravex::writebackend} backend - The preferred output backend.
+ * @param {uint32_t} batch - The number of files written per I/O ring submission.
+ */
+dravex::filewriter::filewriter(const dravex::writebackend backend, const uint32_t batch)
+    : backend_{dravex::writebackend::stdio}
+    , ring_{nullptr}
+    , batch_{std::clamp<uint32_t>(batch, 1, 256)}
+    , calls_{0}
+    , aligned_{nullptr}
+    , clone_{true}
+    , cluster_{0}
+    , copied_{0}
+    , cloned_{0}
+{
+    if (backend == dravex::writebackend::ioring)
+    {
+        this->ring_ = create_ioring(this->batch_);
+        if (this->ring_ != nullptr)
+        {
+            this->backend_ = dravex::writebackend::ioring;
+            this->pending_.reserve(this->batch_);
+            this->spare_.reserve(this->batch_);
+        }
+        else
+            DRAVEX_LOG(dravex::loglevel::debug, "[filewriter] I/O ring is not available; using stdio.");
+    }
+
+    if (backend == dravex::writebackend::direct)
+    {
+        // Page aligned, and so sector aligned..
+        this->aligned_ = static_cast<uint8_t*>(::VirtualAlloc(nullptr, direct_chunk, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        if (this->aligned_ != nullptr)
+            this->backend_ = dravex::writebackend::direct;
+        else
+            DRAVEX_LOG(dravex::loglevel::debug, "[filewriter] failed to allocate the direct staging buffer; using stdio.");
+    }
+}
+dravex::filewriter::~filewriter(void)
+{
+    this->flush();
+
+    if (this->ring_ != nullptr)
+        get_ioring_api().close_(this->ring_);
+    if (this->aligned_ != nullptr)
+        ::VirtualFree(this->aligned_, 0, MEM_RELEASE);
+
+    for (auto& buffer : this->spare_)
+        dravex::bufferpool::release(std::move(buffer));
+}
+
+/**
+ * Takes a buffer of at least the given size to fill and pass to write.
+ *
+ * The ioring backend keeps a whole batch of buffers in flight, more than the buffer pool keeps per size
+ * class. The buffers of completed writes are kept by the writer and handed out again here; the buffer pool
+ * is only used when none of them is large enough.
+ *
+ * @param {std::size_t} size - The buffer size.
+ * @return {dravex::bytebuffer_t} The buffer, resized to the given size. (Its contents are uninitialised.)
+ */
+dravex::bytebuffer_t dravex::filewriter::acquire(const std::size_t size)
+{
+    if (size == 0)
+        return {};
+
+    // Take the smallest spare buffer that can hold the data..
+    auto best = this->spare_.end();
+    for (auto iter = this->spare_.begin(); iter != this->spare_.end(); ++iter)
+    {
+        if (iter->capacity() >= size && (best == this->spare_.end() || iter->capacity() < best->capacity()))
+            best = iter;
+    }
+
+    if (best == this->spare_.end())
+        return dravex::bufferpool::acquire(size);
+
+    auto buffer = std::move(*best);
+    this->spare_.erase(best);
+
+    buffer.resize(size);
+    dravex::stats::instance().add(dravex::counter::pool_hits, 1);
+    return buffer;
+}
+
+/**
+ * Writes the given data to the given file.
+ *
+ * With the ioring backend the buffer is taken by the writer and the write is only queued; the file is
+ * written by a later write call or by flush.
+ *
+ * @param {std::string&} path - The file path.
+ * @param {dravex::bytebuffer_t&} buffer - The data to write.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::filewriter::write(const std::string& path, dravex::bytebuffer_t& buffer)
+{
+    if (this->backend_ == dravex::writebackend::direct)
+        return this->write_direct(path, [&buffer, offset = std::size_t{0}](uint8_t* output, const std::size_t size) mutable {
+            const auto count = std::min(size, buffer.size() - offset);
+            std::memcpy(output, buffer.data() + offset, count);
+            offset += count;
+            return count;
+        });
+
+    if (this->backend_ == dravex::writebackend::stdio)
+    {
+        FILE* f = nullptr;
+        if (::fopen_s(&f, path.c_str(), "wb") != ERROR_SUCCESS)
+            return false;
+
+        auto done = buffer.empty() || ::fwrite(buffer.data(), buffer.size(), 1, f) == 1;
+        done      = ::fclose(f) == 0 && done;
+
+        // Counted as one open, write and close..
+        this->calls_ += 3;
+        return done;
+    }
+
+    const auto handle = ::CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    this->calls_++;
+
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    // Queue the write..
+    if (!buffer.empty())
+    {
+        ioringref_t file{ioring_ref_raw, {}};
+        ioringref_t data{ioring_ref_raw, {}};
+        file.handle_  = handle;
+        data.address_ = buffer.data();
+
+        if (FAILED(get_ioring_api().build_write_(this->ring_, file, data, static_cast<uint32_t>(buffer.size()), 0, 0, this->pending_.size(), 0)))
+        {
+            ::CloseHandle(handle);
+            this->calls_++;
+            return false;
+        }
+    }
+
+    this->pending_.push_back({handle, std::move(buffer), path});
+    buffer = {};
+
+    if (this->pending_.size() >= this->batch_)
+        this->flush();
+
+    return true;
+}
+
+/**
+ * Writes the data of the given entry reader to the given file, a chunk at a time.
+ *
+ * The file is written before returning with any backend and only a single chunk of the entry is held in
+ * memory, regardless of the entry size.
+ *
+ * @param {std::string&} path - The file path.
+ * @param {dravex::entryreader&} reader - The reader of the entry to write.
+ * @param {uint32_t&} adler - The Adler-32 of the written data.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::filewriter::write(const std::string& path, dravex::entryreader& reader, uint32_t& adler)
+{
+    adler = adler32_z(0L, Z_NULL, 0);
+
+    // Reads the next chunk of the entry, updating the checksum..
+    const auto fill = [&reader, &adler](uint8_t* output, const std::size_t size) {
+        const auto count = reader.read(output, size);
+        adler            = adler32_z(adler, output, count);
+        return count;
+    };
+
+    auto done = false;
+    if (this->backend_ == dravex::writebackend::direct)
+        done = this->write_direct(path, fill);
+    else
+    {
+        FILE* f = nullptr;
+        if (::fopen_s(&f, path.c_str(), "wb") != ERROR_SUCCESS)
+            return false;
+
+        dravex::pooledbuffer chunk{stream_chunk};
+        auto& buffer = chunk.get();
+        buffer.resize(stream_chunk);
+
+        done = true;
+        for (auto count = fill(buffer.data(), buffer.size()); count != 0 && done; count = fill(buffer.data(), buffer.size()))
+        {
+            done = ::fwrite(buffer.data(), 1, count, f) == count;
+            this->calls_++;
+        }
+
+        done = ::fclose(f) == 0 && done;
+
+        // Counted as one open and close..
+        this->calls_ += 2;
+    }
+
+    return done && !reader.has_failed() && reader.get_position() == reader.get_size();
+}
+
+/**
+ * Copies the given uncompressed entry to the given file, straight from the mapped game.pkg file.
+ *
+ * The copy is written before returning with any backend.
+ *
+ * @param {std::string&} path - The file path.
+ * @param {dravex::entryview_t&} view - The view of the entry data.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::filewriter::copy(const std::string& path, const dravex::entryview_t& view)
+{
+    if (this->backend_ == dravex::writebackend::direct)
+        return this->write_direct(path, [&view, offset = std::size_t{0}](uint8_t* output, const std::size_t size) mutable {
+            const auto count = std::min<std::size_t>(size, view.size_ - offset);
+            std::memcpy(output, view.data_ + offset, count);
+            offset += count;
+            return count;
+        });
+
+    const auto handle = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    this->calls_++;
+
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    auto done = view.size_ == 0;
+
+    // Clone the entry extents when possible..
+    if (!done && this->clone(handle, view))
+    {
+        this->cloned_ += view.size_;
+        done = true;
+    }
+
+    // Otherwise write the mapped data; the pages are read in by the kernel as they are written..
+    if (!done)
+    {
+        DWORD written = 0;
+        done = ::WriteFile(handle, view.data_, view.size_, &written, nullptr) && written == view.size_;
+        this->calls_++;
+    }
+
+    ::CloseHandle(handle);
+    this->calls_++;
+
+    if (done)
+        this->copied_ += view.size_;
+
+    return done;
+}
+
+/**
+ * Clones the extents of the given uncompressed entry into the given file.
+ *
+ * The source range must start on a cluster boundary; it is rounded up to whole clusters and the file is
+ * trimmed back to the entry size afterwards.
+ *
+ * @param {HANDLE} handle - The output file handle.
+ * @param {dravex::entryview_t&} view - The view of the entry data.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::filewriter::clone(HANDLE handle, const dravex::entryview_t& view)
+{
+    if (!this->clone_ || view.file_ == INVALID_HANDLE_VALUE)
+        return false;
+
+    DWORD returned = 0;
+
+    // Query the cluster size of the output volume..
+    if (this->cluster_ == 0)
+    {
+        integrityinfo_t info{};
+        this->calls_++;
+
+        if (!::DeviceIoControl(handle, fsctl_get_integrity_information, nullptr, 0, &info, sizeof(info), &returned, nullptr) || info.cluster_size_ == 0)
+        {
+            this->clone_ = false;
+            return false;
+        }
+
+        this->cluster_ = info.cluster_size_;
+    }
+
+    const auto length = (static_cast<uint64_t>(view.size_) + this->cluster_ - 1) / this->cluster_ * this->cluster_;
+    if (view.offset_ % this->cluster_ != 0 || view.offset_ + length > view.file_size_)
+        return false;
+
+    // Size the file to hold the cloned clusters..
+    FILE_END_OF_FILE_INFO eof{};
+    eof.EndOfFile.QuadPart = static_cast<LONGLONG>(length);
+    this->calls_++;
+
+    if (!::SetFileInformationByHandle(handle, FileEndOfFileInfo, &eof, sizeof(eof)))
+        return false;
+
+    duplicateextents_t extents{};
+    extents.file_                   = view.file_;
+    extents.source_offset_.QuadPart = static_cast<LONGLONG>(view.offset_);
+    extents.target_offset_.QuadPart = 0;
+    extents.byte_count_.QuadPart    = static_cast<LONGLONG>(length);
+    this->calls_++;
+
+    const auto cloned = ::DeviceIoControl(handle, fsctl_duplicate_extents_to_file, &extents, sizeof(extents), nullptr, 0, &returned, nullptr) != FALSE;
+
+    // Stop cloning if the volume refused it; ie. the output is on another volume than the game.pkg file..
+    if (!cloned)
+        this->clone_ = false;
+
+    // Trim the file to the entry size.. (Or empty it again for the write fallback.)
+    eof.EndOfFile.QuadPart = cloned ? view.size_ : 0;
+    this->calls_++;
+
+    return ::SetFileInformationByHandle(handle, FileEndOfFileInfo, &eof, sizeof(eof)) && cloned;
+}
+
+/**
+ * Writes the data produced by the given fill function to the given file, unbuffered and write-through.
+ *
+ * Unbuffered writes must be sector aligned in address, offset and size; the data is staged through the
+ * aligned buffer a chunk at a time, the last chunk padded to a whole sector and the padding trimmed after.
+ *
+ * @param {std::string&} path - The file path.
+ * @param {std::function&} fill - Fills the given buffer with up to the given number of bytes; returns the bytes filled. (Fewer once the data ends.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::filewriter::write_direct(const std::string& path, const std::function<std::size_t(uint8_t*, std::size_t)>& fill)
+{
+    const auto handle = ::CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH, nullptr);
+    this->calls_++;
+
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    auto done      = true;
+    uint64_t total = 0;
+
+    while (done)
+    {
+        const auto chunk = fill(this->aligned_, direct_chunk);
+        if (chunk == 0)
+            break;
+
+        const auto padded = (chunk + direct_alignment - 1) / direct_alignment * direct_alignment;
+        std::memset(this->aligned_ + chunk, 0, padded - chunk);
+
+        DWORD written = 0;
+        done = ::WriteFile(handle, this->aligned_, static_cast<DWORD>(padded), &written, nullptr) && written == padded;
+        this->calls_++;
+
+        total += chunk;
+        if (chunk < direct_chunk)
+            break;
+    }
+
+    // Trim the padding of the last sector..
+    if (done && total % direct_alignment != 0)
+    {
+        FILE_END_OF_FILE_INFO eof{};
+        eof.EndOfFile.QuadPart = static_cast<LONGLONG>(total);
+
+        done = ::SetFileInformationByHandle(handle, FileEndOfFileInfo, &eof, sizeof(eof)) != FALSE;
+        this->calls_++;
+    }
+
+    ::CloseHandle(handle);
+    this->calls_++;
+
+    return done;
+}
+
+/**
+ * Submits the queued writes, waits for them to complete and closes their files.
+ */
+void dravex::filewriter::flush(void)
+{
+    if (this->pending_.empty())
+        return;
+
+    dravex::tracespan span{"flush", "extract", static_cast<int64_t>(this->pending_.size())};
+
+    const auto& api = get_ioring_api();
+
+    // Submit the writes and wait for all of them to complete..
+    const auto writes = static_cast<uint32_t>(std::count_if(this->pending_.begin(), this->pending_.end(), [](const pending_t& p) {
+        return !p.buffer_.empty();
+    }));
+
+    auto& done = this->done_;
+    done.assign(this->pending_.size(), false);
+
+    if (writes != 0)
+    {
+        uint32_t submitted = 0;
+        this->calls_++;
+
+        if (SUCCEEDED(api.submit_(this->ring_, writes, ioring_wait_never, &submitted)))
+        {
+            ioringcqe_t cqe{};
+            while (api.pop_completion_(this->ring_, &cqe) == ioring_cqe_popped)
+            {
+                if (cqe.user_data_ < done.size())
+                    done[cqe.user_data_] = SUCCEEDED(cqe.result_) && cqe.information_ == this->pending_[cqe.user_data_].buffer_.size();
+            }
+        }
+    }
+
+    // Close the files and keep the buffers for the next batch..
+    for (std::size_t x = 0; x < this->pending_.size(); x++)
+    {
+        auto& p = this->pending_[x];
+
+        ::CloseHandle(p.handle_);
+        this->calls_++;
+
+        if (!done[x] && !p.buffer_.empty())
+            this->failed_.push_back(std::move(p.path_));
+
+        if (p.buffer_.capacity() != 0 && this->spare_.size() < this->batch_)
+            this->spare_.push_back(std::move(p.buffer_));
+        else
+            dravex::bufferpool::release(std::move(p.buffer_));
+    }
+
+    this->pending_.clear();
+}
+
+/**
+ * Returns the output backend in use.
+ *
+ * @return {dravex::writebackend} The output backend.
+ */
+dravex::writebackend dravex::filewriter::get_backend(void) const
+{
+    return this->backend_;
+}
+
+/**
+ * Returns the paths of the queued writes that failed.
+ *
+ * @return {std::vector&} The failed paths.
+ */
+const std::vector<std::string>& dravex::filewriter::get_failed(void) const
+{
+    return this->failed_;
+}
+
+/**
+ * Returns the number of writes queued and not yet completed.
+ *
+ * @return {std::size_t} The queued write count.
+ */
+std::size_t dravex::filewriter::get_queued(void) const
+{
+    return this->pending_.size();
+}
+
+/**
+ * Returns the number of file API calls made by the writer. (Open, write or submit, and close.)
+ *
+ * @return {uint64_t} The call count.
+ */
+uint64_t dravex::filewriter::get_calls(void) const
+{
+    return this->calls_;
+}
+
+/**
+ * Returns the number of uncompressed entry bytes copied from the mapped game.pkg file.
+ *
+ * @return {uint64_t} The copied byte count. (Includes the cloned bytes.)
+ */
+uint64_t dravex::filewriter::get_copied(void) const
+{
+    return this->copied_;
+}
+
+/**
+ * Returns the number of uncompressed entry bytes cloned from the game.pkg file.
+ *
+ * @return {uint64_t} The cloned byte count.
+ */
+uint64_t dravex::filewriter::get_cloned(void) const
+{
+    return this->cloned_;
+}
+
+/**
+ * Returns if the I/O ring backend is available on this system.
+ *
+ * @return {bool} True if available, false otherwise.
+ */
+bool dravex::filewriter::is_ioring_supported(void)
+{
+    static const auto supported = [] {
+        const auto ring = create_ioring(1);
+        if (ring != nullptr)
+            get_ioring_api().close_(ring);
+        return ring != nullptr;
+    }();
+
+    return supported;
+}
+
+/**
+ * Returns the display name of the given output backend.
+ *
+ * @param {dravex::writebackend} backend - The output backend.
+ * @return {const char*} The backend name.
+ */
+const char* dravex::filewriter::get_backend_name(const dravex::writebackend backend)
+{
+    switch (backend)
+    {
+        case dravex::writebackend::stdio:
+            return "stdio";
+        case dravex::writebackend::ioring:
+            return "ioring";
+        case dravex::writebackend::direct:
+            return "direct";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_FILEWRITER_HPP
+#define PACKAGE_FILEWRITER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "entryreader.hpp"
+#include "package.hpp"
+
+namespace dravex
+{
+    /**
+     * Output backends used to write extracted files.
+     */
+    enum class writebackend : uint32_t
+    {
+        stdio = 0, // fopen, fwrite and fclose per file..
+        ioring,    // Windows I/O ring; writes are queued and submitted in batches..
+        direct,    // Unbuffered, write-through files written from sector aligned buffers; bypasses the system cache..
+    };
+
+    /**
+     * Output file writer, owned by a single extraction worker.
+     *
+     * The stdio backend writes each file before returning. The ioring backend creates the file, queues its
+     * write into a Windows I/O ring (Windows 11 22H2 and newer) and submits the queued writes of a whole batch
+     * of files with a single call, closing the files once their writes complete. The I/O ring functions are
+     * resolved at runtime; the writer falls back to the stdio backend when they are not available.
+     *
+     * The direct backend opens each file with FILE_FLAG_NO_BUFFERING and FILE_FLAG_WRITE_THROUGH so extracting
+     * does not fill the system cache with the output. The data is staged through a sector aligned buffer and
+     * the padding of the last sector is trimmed once the file is written.
+     *
+     * Uncompressed entries are copied with either backend straight from the mapped game.pkg file. The copy
+     * clones the entry extents when the output volume supports block cloning (ReFS) and the entry is cluster
+     * aligned, otherwise the mapped data is handed to WriteFile without first being copied into a buffer. (The
+     * direct backend stages the mapped data through its aligned buffer instead.)
+     */
+    class filewriter final
+    {
+        filewriter(filewriter const&)            = delete;
+        filewriter(filewriter&&)                 = delete;
+        filewriter& operator=(filewriter const&) = delete;
+        filewriter& operator=(filewriter&&)      = delete;
+
+        /**
+         * Structure definition for a queued file write.
+         */
+        struct pending_t
+        {
+            HANDLE handle_;
+            dravex::bytebuffer_t buffer_;
+            std::string path_;
+        };
+
+        dravex::writebackend backend_;
+        void* ring_;
+        uint32_t batch_;
+        std::vector<pending_t> pending_;
+        std::vector<dravex::bytebuffer_t> spare_; // Buffers of completed writes, reused by acquire..
+        std::vector<bool> done_;                  // Completion state of the pending writes, reused by flush..
+        std::vector<std::string> failed_;
+        uint64_t calls_;
+        uint8_t* aligned_; // Staging buffer of the direct backend..
+
+        bool clone_;       // Cleared once block cloning fails; ie. the output is not on the game.pkg volume..
+        uint32_t cluster_; // Cluster size of the output volume, queried on the first copy..
+        uint64_t copied_;
+        uint64_t cloned_;
+
+        auto clone(HANDLE handle, const dravex::entryview_t& view) -> bool;
+        auto write_direct(const std::string& path, const std::function<std::size_t(uint8_t*, std::size_t)>& fill) -> bool;
+
+    public:
+        filewriter(const dravex::writebackend backend, const uint32_t batch = 32);
+        ~filewriter(void);
+
+        auto acquire(const std::size_t size) -> dravex::bytebuffer_t;
+        auto write(const std::string& path, dravex::bytebuffer_t& buffer) -> bool;
+        auto write(const std::string& path, dravex::entryreader& reader, uint32_t& adler) -> bool;
+        auto copy(const std::string& path, const dravex::entryview_t& view) -> bool;
+        auto flush(void) -> void;
+
+        auto get_backend(void) const -> dravex::writebackend;
+        auto get_failed(void) const -> const std::vector<std::string>&;
+        auto get_queued(void) const -> std::size_t;
+        auto get_calls(void) const -> uint64_t;
+        auto get_copied(void) const -> uint64_t;
+        auto get_cloned(void) const -> uint64_t;
+
+        static auto is_ioring_supported(void) -> bool;
+        static auto get_backend_name(const dravex::writebackend backend) -> const char*;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_FILEWRITER_HPP
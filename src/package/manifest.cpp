@@ -0,0 +1,161 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "manifest.hpp"
+#include "package.hpp"
+#include "../logging.hpp"
+#include "../utils.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::manifestwriter::manifestwriter(void)
+    : json_{nullptr}
+    , binary_{nullptr}
+    , count_{0}
+{}
+dravex::manifestwriter::~manifestwriter(void)
+{
+    this->close();
+}
+
+/**
+ * Opens the manifest files for writing, replacing any existing files.
+ *
+ * @param {std::filesystem::path&} json - The JSON lines manifest path. (Empty to not write it.)
+ * @param {std::filesystem::path&} binary - The binary manifest path. (Empty to not write it.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::manifestwriter::open(const std::filesystem::path& json, const std::filesystem::path& binary)
+{
+    this->close();
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    this->count_ = 0;
+
+    if (!json.empty() && ::fopen_s(&this->json_, json.string().c_str(), "wb") != ERROR_SUCCESS)
+    {
+        DRAVEX_LOG(dravex::loglevel::error, "[manifest] failed to open the manifest for writing: {}", json.string());
+        return false;
+    }
+
+    if (!binary.empty())
+    {
+        if (::fopen_s(&this->binary_, binary.string().c_str(), "wb") != ERROR_SUCCESS)
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[manifest] failed to open the manifest for writing: {}", binary.string());
+            return false;
+        }
+
+        const dravex::diskmanifestheader_t header{dravex::manifest_magic, dravex::manifest_version};
+        ::fwrite(&header, sizeof(header), 1, this->binary_);
+    }
+
+    return true;
+}
+
+/**
+ * Flushes and closes the manifest files. (The record count is kept until the manifest is opened again.)
+ */
+void dravex::manifestwriter::close(void)
+{
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    if (this->json_ != nullptr)
+        ::fclose(this->json_);
+    if (this->binary_ != nullptr)
+        ::fclose(this->binary_);
+
+    this->json_   = nullptr;
+    this->binary_ = nullptr;
+}
+
+/**
+ * Writes the given record to the open manifest files.
+ *
+ * @param {dravex::manifestrecord_t&} record - The record to write.
+ */
+void dravex::manifestwriter::write(const dravex::manifestrecord_t& record)
+{
+    // Prepare the record outside of the lock..
+    std::string line;
+    if (this->json_ != nullptr)
+    {
+        line = std::format(R"({{"path": "{}", "type": {}, "ext": "{}", "index": {}, "layer": {}, "offset": {}, "size": {}, "size_compressed": {}, "compressed": {}, )",
+                           dravex::utils::json_escape(record.path_), record.file_type_, dravex::package::get_extension(record.file_type_), record.index_, record.layer_, record.data_offset_,
+                           record.size_uncompressed_, record.size_compressed_, (record.flags_ & dravex::manifest_flag_compressed) != 0);
+        line += std::format(R"("adler32": "{:08X}", "output": "{}", "stored": {}, "skipped": {}}})",
+                            record.adler32_, dravex::utils::json_escape(record.output_), (record.flags_ & dravex::manifest_flag_stored) != 0, (record.flags_ & dravex::manifest_flag_skipped) != 0);
+        line += '\n';
+    }
+
+    dravex::diskmanifestrecord_t disk{};
+    disk.index_             = record.index_;
+    disk.file_type_         = record.file_type_;
+    disk.data_offset_       = record.data_offset_;
+    disk.size_compressed_   = record.size_compressed_;
+    disk.size_uncompressed_ = record.size_uncompressed_;
+    disk.adler32_           = record.adler32_;
+    disk.layer_             = static_cast<uint16_t>(record.layer_);
+    disk.flags_             = record.flags_;
+    disk.path_size_         = static_cast<uint16_t>(std::min<std::size_t>(record.path_.size(), 0xFFFF));
+    disk.output_size_       = static_cast<uint16_t>(std::min<std::size_t>(record.output_.size(), 0xFFFF));
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    if (this->json_ != nullptr)
+        ::fwrite(line.data(), line.size(), 1, this->json_);
+
+    if (this->binary_ != nullptr)
+    {
+        ::fwrite(&disk, sizeof(disk), 1, this->binary_);
+        ::fwrite(record.path_.data(), disk.path_size_, 1, this->binary_);
+        ::fwrite(record.output_.data(), disk.output_size_, 1, this->binary_);
+    }
+
+    this->count_++;
+}
+
+/**
+ * Returns if any manifest file is open.
+ *
+ * @return {bool} True if open, false otherwise.
+ */
+bool dravex::manifestwriter::is_open(void) const
+{
+    return this->json_ != nullptr || this->binary_ != nullptr;
+}
+
+/**
+ * Returns the number of records written.
+ *
+ * @return {uint64_t} The record count.
+ */
+uint64_t dravex::manifestwriter::get_count(void) const
+{
+    return this->count_;
+}
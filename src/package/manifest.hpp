@@ -0,0 +1,123 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_MANIFEST_HPP
+#define PACKAGE_MANIFEST_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Binary manifest file header.
+     */
+    struct diskmanifestheader_t
+    {
+        uint32_t magic_; // 'DRXM'
+        uint32_t version_;
+    };
+
+    /**
+     * Binary manifest record. (Followed by the path and output location, without terminators.)
+     */
+    struct diskmanifestrecord_t
+    {
+        uint32_t index_;
+        uint32_t file_type_;
+        uint32_t data_offset_;
+        uint32_t size_compressed_;
+        uint32_t size_uncompressed_;
+        uint32_t adler32_;
+        uint16_t layer_;
+        uint16_t flags_;
+        uint16_t path_size_;
+        uint16_t output_size_;
+    };
+
+    constexpr uint32_t manifest_magic   = 0x4D585244;
+    constexpr uint32_t manifest_version = 1;
+
+    /**
+     * Binary manifest record flags.
+     */
+    constexpr uint16_t manifest_flag_compressed = 0x0001; // The entry data is compressed within the package..
+    constexpr uint16_t manifest_flag_skipped    = 0x0002; // The output was up to date and not written..
+    constexpr uint16_t manifest_flag_stored     = 0x0004; // The output location is a content store object..
+
+    /**
+     * Structure definition for a record of the extraction manifest.
+     */
+    struct manifestrecord_t
+    {
+        std::string_view path_;   // The entry path, relative to the extraction root..
+        std::string_view output_; // The location the entry data was extracted to..
+        uint32_t index_;          // The entry index within its package..
+        uint32_t layer_;          // The overlay layer holding the entry. (0 when not extracting an overlay.)
+        uint32_t file_type_;
+        uint32_t data_offset_;
+        uint32_t size_compressed_;
+        uint32_t size_uncompressed_;
+        uint32_t adler32_; // Adler-32 of the extracted data..
+        uint16_t flags_;
+    };
+
+    /**
+     * Extraction manifest writer.
+     *
+     * Records are streamed to the manifest files as entries are extracted; any number of threads can write
+     * records at the same time. A manifest can be written as JSON lines, in a compact binary form, or both.
+     */
+    class manifestwriter final
+    {
+        manifestwriter(manifestwriter const&)            = delete;
+        manifestwriter(manifestwriter&&)                 = delete;
+        manifestwriter& operator=(manifestwriter const&) = delete;
+        manifestwriter& operator=(manifestwriter&&)      = delete;
+
+        std::mutex mutex_;
+        FILE* json_;
+        FILE* binary_;
+        uint64_t count_;
+
+    public:
+        manifestwriter(void);
+        ~manifestwriter(void);
+
+        auto open(const std::filesystem::path& json, const std::filesystem::path& binary) -> bool;
+        auto close(void) -> void;
+        auto write(const dravex::manifestrecord_t& record) -> void;
+
+        auto is_open(void) const -> bool;
+        auto get_count(void) const -> uint64_t;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_MANIFEST_HPP
@@ -0,0 +1,245 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "namestore.hpp"
+
+namespace
+{
+    /**
+     * Appends the given value to the buffer as a variable length integer. (LEB128)
+     *
+     * @param {std::vector<uint8_t>&} buffer - The buffer to append to.
+     * @param {uint32_t} value - The value to append.
+     */
+    void write_varint(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    /**
+     * Reads a variable length integer from the given data, advancing the data pointer. (LEB128)
+     *
+     * @param {uint8_t*&} data - The data to read from.
+     * @return {uint32_t} The value read.
+     */
+    uint32_t read_varint(const uint8_t*& data)
+    {
+        uint32_t value = 0;
+        uint32_t shift = 0;
+        while (*data & 0x80)
+        {
+            value |= static_cast<uint32_t>(*data++ & 0x7F) << shift;
+            shift += 7;
+        }
+        return value | (static_cast<uint32_t>(*data++) << shift);
+    }
+
+    /**
+     * Decodes the next name of a block, replacing the previous name held in the output.
+     *
+     * @param {uint8_t*&} data - The block data to read from.
+     * @param {std::string&} output - The previous name, replaced with the decoded name.
+     */
+    void decode_name(const uint8_t*& data, std::string& output)
+    {
+        const auto shared = read_varint(data);
+        const auto length = read_varint(data);
+
+        output.resize(shared);
+        output.append(reinterpret_cast<const char*>(data), length);
+        data += length;
+    }
+
+} // namespace
+
+/**
+ * Constructor and Destructor
+ */
+dravex::namestore::namestore(void)
+    : raw_size_{0}
+{}
+dravex::namestore::~namestore(void)
+{}
+
+/**
+ * Builds the store from the given names, replacing its current contents.
+ *
+ * @param {std::vector<std::string_view>&} names - The names to store, addressed by their index afterward.
+ */
+void dravex::namestore::build(const std::vector<std::string_view>& names)
+{
+    this->clear();
+
+    const auto count = static_cast<uint32_t>(names.size());
+
+    // Sort the names, keeping the original order for equal names..
+    this->order_.resize(count);
+    std::iota(this->order_.begin(), this->order_.end(), 0u);
+    std::stable_sort(this->order_.begin(), this->order_.end(), [&names](const uint32_t a, const uint32_t b) {
+        return names[a] < names[b];
+    });
+
+    this->ranks_.resize(count);
+    this->restarts_.reserve((count + block_size - 1) / block_size);
+
+    // Encode the names..
+    std::string_view prev{};
+    for (uint32_t x = 0; x < count; x++)
+    {
+        const auto index = this->order_[x];
+        const auto name  = names[index];
+
+        this->ranks_[index] = x;
+        this->raw_size_ += name.size() + 1;
+
+        // Start a new block, storing the name in full..
+        std::size_t shared = 0;
+        if (x % block_size == 0)
+            this->restarts_.push_back(static_cast<uint32_t>(this->data_.size()));
+        else
+        {
+            const auto limit = std::min(prev.size(), name.size());
+            while (shared < limit && prev[shared] == name[shared])
+                shared++;
+        }
+
+        write_varint(this->data_, static_cast<uint32_t>(shared));
+        write_varint(this->data_, static_cast<uint32_t>(name.size() - shared));
+        this->data_.insert(this->data_.end(), name.begin() + shared, name.end());
+
+        prev = name;
+    }
+
+    this->data_.shrink_to_fit();
+}
+
+/**
+ * Clears the store, releasing its memory.
+ */
+void dravex::namestore::clear(void)
+{
+    std::vector<uint8_t>().swap(this->data_);
+    std::vector<uint32_t>().swap(this->restarts_);
+    std::vector<uint32_t>().swap(this->order_);
+    std::vector<uint32_t>().swap(this->ranks_);
+
+    this->raw_size_ = 0;
+}
+
+/**
+ * Returns the number of names held in the store.
+ *
+ * @return {std::size_t} The name count.
+ */
+std::size_t dravex::namestore::get_count(void) const noexcept
+{
+    return this->order_.size();
+}
+
+/**
+ * Decodes the name with the given index.
+ *
+ * @param {uint32_t} index - The index of the name, as given to build.
+ * @param {std::string&} output - The string to hold the decoded name.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::namestore::get_name(const uint32_t index, std::string& output) const
+{
+    if (index >= this->ranks_.size())
+        return false;
+
+    this->get_sorted_name(this->ranks_[index], output);
+    return true;
+}
+
+/**
+ * Decodes the name at the given sorted position.
+ *
+ * @param {uint32_t} position - The sorted position of the name.
+ * @param {std::string&} output - The string to hold the decoded name.
+ * @return {uint32_t} The index of the name on success, 0xFFFFFFFF otherwise.
+ */
+uint32_t dravex::namestore::get_sorted_name(const uint32_t position, std::string& output) const
+{
+    output.clear();
+
+    if (position >= this->order_.size())
+        return 0xFFFFFFFF;
+
+    // Decode from the restart point of the block up to the requested name..
+    auto data = this->data_.data() + this->restarts_[position / block_size];
+    for (uint32_t x = 0; x <= position % block_size; x++)
+        decode_name(data, output);
+
+    return this->order_[position];
+}
+
+/**
+ * Invokes the given function for every name in sorted order.
+ *
+ * The names are decoded incrementally; the view passed to the function is only valid during the call.
+ *
+ * @param {std::function} func - The function to invoke with the name index and name. Returns false to stop iterating.
+ */
+void dravex::namestore::for_each(const std::function<bool(uint32_t, std::string_view)>& func) const
+{
+    std::string name;
+
+    auto data = this->data_.data();
+    for (uint32_t x = 0; x < this->order_.size(); x++)
+    {
+        decode_name(data, name);
+
+        if (!func(this->order_[x], name))
+            return;
+    }
+}
+
+/**
+ * Returns the memory used by the store. (Name blocks, restart points and index tables.)
+ *
+ * @return {std::size_t} The store size in bytes.
+ */
+std::size_t dravex::namestore::get_size(void) const noexcept
+{
+    return this->data_.size()
+           + sizeof(uint32_t) * (this->restarts_.size() + this->order_.size() + this->ranks_.size());
+}
+
+/**
+ * Returns the memory the stored names would use verbatim. (Including their terminators.)
+ *
+ * @return {std::size_t} The verbatim size in bytes.
+ */
+std::size_t dravex::namestore::get_raw_size(void) const noexcept
+{
+    return this->raw_size_;
+}
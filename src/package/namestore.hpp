@@ -0,0 +1,84 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_NAMESTORE_HPP
+#define PACKAGE_NAMESTORE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Front-coded (incremental prefix) name store.
+     *
+     * Names are sorted and stored in blocks of block_size names. The first name of each block (the restart
+     * point) is stored in full; every other name only stores the length of the prefix it shares with the
+     * previous name followed by the remaining suffix. Asset paths share long directory prefixes, so this
+     * stores a small fraction of the verbatim string table while keeping random access bounded to decoding
+     * a single block.
+     *
+     * Names are addressed by the index they were given in (the entry index) or by their sorted position.
+     */
+    class namestore final
+    {
+        namestore(namestore const&)            = delete;
+        namestore(namestore&&)                 = delete;
+        namestore& operator=(namestore const&) = delete;
+        namestore& operator=(namestore&&)      = delete;
+
+    public:
+        static constexpr uint32_t block_size = 16;
+
+    private:
+        std::vector<uint8_t> data_;      // Front-coded name blocks.
+        std::vector<uint32_t> restarts_; // Offset of each block within data_.
+        std::vector<uint32_t> order_;    // Sorted position to name index.
+        std::vector<uint32_t> ranks_;    // Name index to sorted position.
+        std::size_t raw_size_;
+
+    public:
+        namestore(void);
+        ~namestore(void);
+
+        auto build(const std::vector<std::string_view>& names) -> void;
+        auto clear(void) -> void;
+
+        auto get_count(void) const noexcept -> std::size_t;
+        auto get_name(const uint32_t index, std::string& output) const -> bool;
+        auto get_sorted_name(const uint32_t position, std::string& output) const -> uint32_t;
+        auto for_each(const std::function<bool(uint32_t, std::string_view)>& func) const -> void;
+
+        auto get_size(void) const noexcept -> std::size_t;
+        auto get_raw_size(void) const noexcept -> std::size_t;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_NAMESTORE_HPP
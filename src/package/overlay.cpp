@@ -0,0 +1,343 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "overlay.hpp"
+#include "../logging.hpp"
+#include "../trace.hpp"
+#include "../utils.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::overlay::overlay(void)
+    : table_mask_{0}
+    , replaced_{0}
+{}
+dravex::overlay::~overlay(void)
+{}
+
+/**
+ * Creates a new, empty overlay.
+ *
+ * @return {std::shared_ptr} The overlay handle.
+ */
+std::shared_ptr<dravex::overlay> dravex::overlay::create(void)
+{
+    return std::make_shared<dravex::overlay>();
+}
+
+/**
+ * Returns the name of the given merged entry, decoded into the scratch string.
+ *
+ * @param {uint32_t} index - The merged entry index.
+ * @param {std::string&} scratch - The string to hold the entry name.
+ * @return {std::string_view} The entry name.
+ */
+std::string_view dravex::overlay::get_name_view(const uint32_t index, std::string& scratch) const
+{
+    const auto& e = this->entries_[index];
+    if (!this->layers_[e.layer_]->get_entry_name(static_cast<int32_t>(e.index_), scratch))
+        scratch.clear();
+
+    return scratch;
+}
+
+/**
+ * Adds a package to the overlay. (Applies once the overlay is built.)
+ *
+ * @param {dravex::packageptr_t&} pkg - The package to add.
+ * @param {int32_t} priority - The priority of the layer; higher priority layers replace the entries of lower ones.
+ */
+void dravex::overlay::add_layer(const dravex::packageptr_t& pkg, const int32_t priority)
+{
+    // Keep the layers ordered from the lowest to the highest priority, stacking equal priorities in order..
+    const auto pos    = std::upper_bound(this->priorities_.begin(), this->priorities_.end(), priority);
+    const auto offset = std::distance(this->priorities_.begin(), pos);
+
+    this->priorities_.insert(pos, priority);
+    this->layers_.insert(this->layers_.begin() + offset, pkg);
+}
+
+/**
+ * Removes all layers and clears the merged index.
+ */
+void dravex::overlay::clear(void)
+{
+    this->layers_.clear();
+    this->priorities_.clear();
+    this->entries_.clear();
+    this->table_.clear();
+    this->table_mask_ = 0;
+    this->replaced_   = 0;
+}
+
+/**
+ * Builds the merged index of the overlay layers.
+ *
+ * Entries keep the position of the lowest layer holding their path; entries only found in higher layers
+ * follow in layer order.
+ *
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::overlay::build(void)
+{
+    dravex::tracespan span{"overlay::build", "package"};
+
+    this->entries_.clear();
+    this->table_.clear();
+    this->table_mask_ = 0;
+    this->replaced_   = 0;
+
+    std::size_t total = 0;
+    for (const auto& pkg : this->layers_)
+    {
+        if (pkg == nullptr || pkg->is_opening())
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[overlay] cannot build overlay; a layer is not open..");
+            return false;
+        }
+
+        total += pkg->get_entry_count();
+    }
+
+    this->entries_.reserve(total);
+    this->table_.assign(dravex::utils::get_table_size(total), 0);
+    this->table_mask_ = static_cast<uint32_t>(this->table_.size() - 1);
+
+    std::string name;
+    std::string scratch;
+
+    for (uint32_t layer = 0; layer < this->layers_.size(); layer++)
+    {
+        const auto& pkg  = this->layers_[layer];
+        const auto count = static_cast<uint32_t>(pkg->get_entry_count());
+
+        for (uint32_t x = 0; x < count; x++)
+        {
+            if (!pkg->get_entry_name(static_cast<int32_t>(x), name))
+                continue;
+
+            auto slot = dravex::utils::hash_path(name) & this->table_mask_;
+            while (this->table_[slot] != 0 && !dravex::utils::equal_path(this->get_name_view(this->table_[slot] - 1, scratch), name))
+                slot = (slot + 1) & this->table_mask_;
+
+            // Replace the entry of the lower layer..
+            if (this->table_[slot] != 0)
+            {
+                this->entries_[this->table_[slot] - 1] = {layer, x};
+                this->replaced_++;
+                continue;
+            }
+
+            this->entries_.push_back({layer, x});
+            this->table_[slot] = static_cast<uint32_t>(this->entries_.size());
+        }
+    }
+
+    DRAVEX_LOG(dravex::loglevel::info, "[overlay] merged {} layer(s): {} entries, {} replaced, {} bytes", this->layers_.size(), this->entries_.size(), this->replaced_, this->get_index_size());
+
+    return true;
+}
+
+/**
+ * Returns the count of layers of the overlay.
+ *
+ * @return {std::size_t} The count of layers.
+ */
+std::size_t dravex::overlay::get_layer_count(void) const
+{
+    return this->layers_.size();
+}
+
+/**
+ * Returns the package of the given layer. (Ordered from the lowest to the highest priority.)
+ *
+ * @param {uint32_t} layer - The layer index.
+ * @return {dravex::packageptr_t} The package on success, nullptr otherwise.
+ */
+dravex::packageptr_t dravex::overlay::get_layer(const uint32_t layer) const
+{
+    return layer >= this->layers_.size()
+               ? nullptr
+               : this->layers_[layer];
+}
+
+/**
+ * Returns the count of merged entries.
+ *
+ * @return {std::size_t} The count of entries.
+ */
+std::size_t dravex::overlay::get_entry_count(void) const
+{
+    return this->entries_.size();
+}
+
+/**
+ * Returns the effective file entry at the given merged index.
+ *
+ * The returned entry is owned by its layer; its index_ is the index within that layer.
+ *
+ * @param {int32_t} index - The merged entry index.
+ * @return {dravex::fileentry_t*} The file entry on success, nullptr otherwise.
+ */
+const dravex::fileentry_t* dravex::overlay::get_entry(const int32_t index) const
+{
+    int32_t local  = 0;
+    const auto pkg = this->resolve(index, local);
+
+    return pkg == nullptr ? nullptr : pkg->get_entry(local);
+}
+
+/**
+ * Returns the layer holding the effective entry at the given merged index.
+ *
+ * @param {int32_t} index - The merged entry index.
+ * @return {uint32_t} The layer index on success, invalid_index otherwise.
+ */
+uint32_t dravex::overlay::get_entry_layer(const int32_t index) const
+{
+    return (index < 0 || static_cast<std::size_t>(index) >= this->entries_.size())
+               ? dravex::invalid_index
+               : this->entries_[index].layer_;
+}
+
+/**
+ * Returns the merged index of the entry with the given path. (Case and separator insensitive.)
+ *
+ * @param {std::string_view} path - The path of the entry to find.
+ * @return {int32_t} The merged entry index on success, -1 otherwise.
+ */
+int32_t dravex::overlay::find_entry(const std::string_view path) const
+{
+    if (this->table_.empty())
+        return -1;
+
+    thread_local std::string scratch;
+
+    auto slot = dravex::utils::hash_path(path) & this->table_mask_;
+    while (this->table_[slot] != 0)
+    {
+        const auto index = this->table_[slot] - 1;
+        if (dravex::utils::equal_path(this->get_name_view(index, scratch), path))
+            return static_cast<int32_t>(index);
+
+        slot = (slot + 1) & this->table_mask_;
+    }
+
+    return -1;
+}
+
+/**
+ * Resolves the given merged index to the package and entry index holding the effective entry.
+ *
+ * @param {int32_t} index - The merged entry index.
+ * @param {int32_t&} local - The entry index within the returned package.
+ * @return {dravex::package*} The package on success, nullptr otherwise.
+ */
+dravex::package* dravex::overlay::resolve(const int32_t index, int32_t& local) const
+{
+    if (index < 0 || static_cast<std::size_t>(index) >= this->entries_.size())
+        return nullptr;
+
+    const auto& e = this->entries_[index];
+    local         = static_cast<int32_t>(e.index_);
+
+    return this->layers_[e.layer_].get();
+}
+
+/**
+ * Reads the data of the effective entry at the given merged index into the given buffer.
+ *
+ * @param {int32_t} index - The merged entry index.
+ * @param {std::vector&} output - The buffer to hold the file data. (Replaced.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::overlay::read_entry(const int32_t index, std::vector<uint8_t>& output) const
+{
+    int32_t local  = 0;
+    const auto pkg = this->resolve(index, local);
+    if (pkg == nullptr)
+    {
+        output.clear();
+        return false;
+    }
+
+    return pkg->read_entry(local, output);
+}
+
+/**
+ * Returns the data of the effective entry at the given merged index, served from its package entry cache when possible.
+ *
+ * @param {int32_t} index - The merged entry index.
+ * @return {dravex::entrybuffer_t} The file data on success, nullptr otherwise.
+ */
+dravex::entrybuffer_t dravex::overlay::get_entry_buffer(const int32_t index) const
+{
+    int32_t local  = 0;
+    const auto pkg = this->resolve(index, local);
+
+    return pkg == nullptr ? nullptr : pkg->get_entry_buffer(local);
+}
+
+/**
+ * Obtains the name of the effective entry at the given merged index.
+ *
+ * @param {int32_t} index - The merged entry index.
+ * @param {std::string&} output - The string to hold the entry name.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::overlay::get_entry_name(const int32_t index, std::string& output) const
+{
+    int32_t local  = 0;
+    const auto pkg = this->resolve(index, local);
+    if (pkg == nullptr)
+    {
+        output.clear();
+        return false;
+    }
+
+    return pkg->get_entry_name(local, output);
+}
+
+/**
+ * Returns the count of entries replaced by a higher layer when the overlay was built.
+ *
+ * @return {std::size_t} The count of replaced entries.
+ */
+std::size_t dravex::overlay::get_replaced_count(void) const
+{
+    return this->replaced_;
+}
+
+/**
+ * Returns the memory footprint of the merged index. (The layers are not included.)
+ *
+ * @return {std::size_t} The index size in bytes.
+ */
+std::size_t dravex::overlay::get_index_size(void) const
+{
+    return this->entries_.size() * sizeof(dravex::overlayentry_t) + this->table_.size() * sizeof(uint32_t);
+}
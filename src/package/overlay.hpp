@@ -0,0 +1,111 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_OVERLAY_HPP
+#define PACKAGE_OVERLAY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "package.hpp"
+
+namespace dravex
+{
+    /**
+     * Structure definition for an entry of an overlay. (References the entry within its owning layer.)
+     */
+    struct overlayentry_t
+    {
+        uint32_t layer_;
+        uint32_t index_;
+    };
+
+    /**
+     * Merged view over several packages.
+     *
+     * Layers are stacked by priority; an entry of a higher priority layer replaces the entry with the same
+     * path (case and separator insensitive) of the layers below it. Layers of equal priority are stacked in
+     * the order they were added. The merged index only references the entries of the layers and does not copy
+     * them; reads are routed to the package owning the effective entry.
+     *
+     * The view is immutable once built and can be used from any number of threads. The layers must remain
+     * open while the view is in use; rebuild the view after a layer is reopened.
+     */
+    class overlay final
+    {
+        overlay(overlay const&)            = delete;
+        overlay(overlay&&)                 = delete;
+        overlay& operator=(overlay const&) = delete;
+        overlay& operator=(overlay&&)      = delete;
+
+        std::vector<dravex::packageptr_t> layers_;
+        std::vector<int32_t> priorities_;
+
+        std::vector<dravex::overlayentry_t> entries_;
+        std::vector<uint32_t> table_;
+        uint32_t table_mask_;
+        std::size_t replaced_;
+
+        auto get_name_view(const uint32_t index, std::string& scratch) const -> std::string_view;
+
+    public:
+        overlay(void);
+        ~overlay(void);
+
+        static std::shared_ptr<overlay> create(void);
+
+    public:
+        auto add_layer(const dravex::packageptr_t& pkg, const int32_t priority = 0) -> void;
+        auto clear(void) -> void;
+        auto build(void) -> bool;
+
+        auto get_layer_count(void) const -> std::size_t;
+        auto get_layer(const uint32_t layer) const -> dravex::packageptr_t;
+
+        auto get_entry_count(void) const -> std::size_t;
+        auto get_entry(const int32_t index) const -> const dravex::fileentry_t*;
+        auto get_entry_layer(const int32_t index) const -> uint32_t;
+        auto find_entry(const std::string_view path) const -> int32_t;
+        auto resolve(const int32_t index, int32_t& local) const -> dravex::package*;
+
+        auto read_entry(const int32_t index, std::vector<uint8_t>& output) const -> bool;
+        auto get_entry_buffer(const int32_t index) const -> dravex::entrybuffer_t;
+        auto get_entry_name(const int32_t index, std::string& output) const -> bool;
+
+        auto get_replaced_count(void) const -> std::size_t;
+        auto get_index_size(void) const -> std::size_t;
+    };
+
+    /**
+     * Shared handle to an overlay.
+     */
+    using overlayptr_t = std::shared_ptr<dravex::overlay>;
+
+} // namespace dravex
+
+#endif // PACKAGE_OVERLAY_HPP
@@ -27,7 +27,10 @@
 #include "package.hpp"
 #include "v118.hpp"
 #include "v666.hpp"
+#include "../bufferpool.hpp"
 #include "../logging.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
 #include "../utils.hpp"
 
 /**
@@ -35,9 +38,349 @@
  */
 dravex::package::package(void)
     : pkg_file_{nullptr}
+    , pkg_handle_{INVALID_HANDLE_VALUE}
+    , pkg_mapping_{nullptr}
+    , pkg_view_{nullptr}
+    , pkg_size_{0}
+    , guid_{}
+    , version_{0}
+    , entries_{nullptr}
+    , entry_count_{0}
+    , names_{nullptr}
+    , names_size_{0}
+    , entry_table_{nullptr}
+    , entry_table_mask_{0}
+    , entry_dirs_{nullptr}
+    , entry_next_{nullptr}
+    , dirs_{nullptr}
+    , dir_count_{0}
+    , dir_table_{nullptr}
+    , dir_table_mask_{0}
+    , dir_names_{nullptr}
+    , access_{dravex::accesspattern::normal}
+    , compact_names_{false}
+    , cache_{64 * 1024 * 1024}
+    , access_span_{0}
+    , access_budget_{16 * 1024 * 1024}
+    , access_bytes_{0}
+    , open_cancel_{false}
+    , opening_{false}
+    , open_result_{false}
+    , open_phase_{static_cast<uint32_t>(dravex::openphase::count)}
+    , open_done_{0}
+    , open_total_{0}
+    , entries_ready_{0}
+    , index_ready_{false}
 {}
 dravex::package::~package(void)
-{}
+{
+    this->cancel_open();
+}
+
+namespace
+{
+    /**
+     * Returns if the given character is a path separator.
+     *
+     * @param {char} c - The character to check.
+     * @return {bool} True if a path separator, false otherwise.
+     */
+    bool is_separator(const char c)
+    {
+        return c == '\\' || c == '/';
+    }
+
+    /**
+     * Returns the stdio open mode of the game.pkg file for the given access pattern.
+     *
+     * The CRT maps the 'S' and 'R' modes onto FILE_FLAG_SEQUENTIAL_SCAN and FILE_FLAG_RANDOM_ACCESS.
+     *
+     * @param {dravex::accesspattern} pattern - The access pattern.
+     * @return {const char*} The open mode.
+     */
+    const char* get_open_mode(const dravex::accesspattern pattern)
+    {
+        switch (pattern)
+        {
+            case dravex::accesspattern::sequential:
+                return "rbS";
+            case dravex::accesspattern::random:
+                return "rbR";
+            default:
+                return "rb";
+        }
+    }
+
+    /**
+     * Returns a view of the given string, empty if the string is invalid.
+     *
+     * @param {char*} str - The string.
+     * @return {std::string_view} The string view.
+     */
+    std::string_view to_view(const char* str)
+    {
+        return str == nullptr ? std::string_view{} : std::string_view{str};
+    }
+
+    /**
+     * The number of entries built between each publish of the entries and progress report while opening.
+     */
+    constexpr uint32_t publish_interval = 4096;
+
+} // namespace
+
+/**
+ * Reserves the index arena and allocates the entry table for a package being parsed.
+ *
+ * The arena is sized up front from the entry count and string table so the whole index is placed within
+ * a single block.
+ *
+ * @param {uint32_t} entry_count - The number of entries in the package.
+ * @param {char*} string_table - The package string table.
+ * @param {uint32_t} string_table_size - The package string table size.
+ */
+void dravex::package::prepare_index(const uint32_t entry_count, const char* string_table, const uint32_t string_table_size)
+{
+    // Count the path separators; every directory in the package starts at one..
+    const auto separators = std::count_if(string_table, string_table + string_table_size, is_separator);
+    const auto dir_limit  = static_cast<std::size_t>(separators) + 1;
+
+    std::size_t size = 0;
+    size += sizeof(dravex::fileentry_t) * entry_count;
+    size += this->compact_names_ ? 0 : string_table_size + 1;
+    size += sizeof(uint32_t) * dravex::utils::get_table_size(entry_count);
+    size += sizeof(uint32_t) * entry_count * 2;
+    size += sizeof(uint32_t) * dravex::utils::get_table_size(dir_limit);
+    size += sizeof(dravex::dirnode_t) * dir_limit;
+    size += 64 * 8; // Alignment padding..
+
+    this->arena_.reserve(size);
+
+    this->entries_     = this->arena_.allocate<dravex::fileentry_t>(entry_count);
+    this->entry_count_ = entry_count;
+}
+
+/**
+ * Copies the string table into the index arena and validates it.
+ *
+ * When compact names are enabled, the copy is placed in a separate arena that is released once the
+ * front-coded name store has been built.
+ *
+ * @param {char*} string_table - The package string table.
+ * @param {uint32_t} string_table_size - The package string table size.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::package::build_names(const char* string_table, const uint32_t string_table_size)
+{
+    dravex::tracespan phase{"parse strings", "package"};
+
+    if (!this->report(dravex::openphase::parse_strings, 0, string_table_size))
+        return false;
+
+    // Copy the table, ensuring it is terminated..
+    auto& arena = this->compact_names_ ? this->names_arena_ : this->arena_;
+    auto names  = arena.allocate<char>(static_cast<std::size_t>(string_table_size) + 1);
+    std::memcpy(names, string_table, string_table_size);
+
+    this->names_      = names;
+    this->names_size_ = string_table_size;
+
+    // Count the strings within the table..
+    uint32_t count  = 0;
+    uint32_t offset = 0;
+    while (offset < string_table_size && names[offset] != '\0')
+    {
+        offset += static_cast<uint32_t>(::strlen(names + offset)) + 1;
+        count++;
+    }
+
+    if (count != this->entry_count_)
+    {
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] invalid string count; cannot continue - got: {}, expected: {}", count, this->entry_count_);
+        return false;
+    }
+
+    return this->report(dravex::openphase::parse_strings, string_table_size, string_table_size);
+}
+
+/**
+ * Makes the given number of built entries visible to readers while the package is being opened.
+ *
+ * With compact names, entries are only made visible once the whole index is built as their names are
+ * moved into the name store last.
+ *
+ * @param {uint32_t} count - The number of entries built.
+ */
+void dravex::package::publish_entries(const uint32_t count)
+{
+    if (!this->compact_names_)
+        this->entries_ready_.store(count, std::memory_order_release);
+}
+
+/**
+ * Builds the path lookup table and directory tree of the parsed entries.
+ *
+ * @return {bool} True on success, false if cancelled.
+ */
+bool dravex::package::build_lookup(void)
+{
+    dravex::tracespan phase{"build lookup", "package"};
+
+    if (!this->report(dravex::openphase::build_lookup, 0, 2))
+        return false;
+
+    // Build the path lookup table..
+    const auto entry_table_size = dravex::utils::get_table_size(this->entry_count_);
+    this->entry_table_          = this->arena_.allocate<uint32_t>(entry_table_size);
+    this->entry_table_mask_     = entry_table_size - 1;
+
+    for (uint32_t x = 0; x < this->entry_count_; x++)
+    {
+        const auto name = to_view(this->get_string(this->entries_[x].string_offset_));
+
+        auto slot = dravex::utils::hash_path(name) & this->entry_table_mask_;
+        while (this->entry_table_[slot] != 0 && !dravex::utils::equal_path(to_view(this->get_string(this->entries_[this->entry_table_[slot] - 1].string_offset_)), name))
+            slot = (slot + 1) & this->entry_table_mask_;
+
+        // Keep the first entry of duplicate paths..
+        if (this->entry_table_[slot] == 0)
+            this->entry_table_[slot] = x + 1;
+    }
+
+    if (!this->report(dravex::openphase::build_lookup, 1, 2))
+        return false;
+
+    // Prepare the directory tables..
+    const auto dir_limit      = static_cast<std::size_t>(std::count_if(this->names_, this->names_ + this->names_size_, is_separator)) + 1;
+    const auto dir_table_size = dravex::utils::get_table_size(dir_limit);
+
+    this->entry_dirs_     = this->arena_.allocate<uint32_t>(this->entry_count_);
+    this->entry_next_     = this->arena_.allocate<uint32_t>(this->entry_count_);
+    this->dir_table_      = this->arena_.allocate<uint32_t>(dir_table_size);
+    this->dir_table_mask_ = dir_table_size - 1;
+    this->dirs_           = this->arena_.allocate<dravex::dirnode_t>(dir_limit);
+    this->dir_names_      = this->names_;
+
+    // Create the root directory..
+    this->dirs_[0]   = {dravex::invalid_index, dravex::invalid_index, dravex::invalid_index, dravex::invalid_index, 0, 0, 0};
+    this->dir_count_ = 1;
+
+    // Build the directory tree..
+    for (uint32_t x = 0; x < this->entry_count_; x++)
+    {
+        const auto offset = this->entries_[x].string_offset_;
+        const auto name   = to_view(this->get_string(offset));
+
+        auto parent = 0u;
+        for (std::size_t pos = 0; pos < name.size(); pos++)
+        {
+            if (!is_separator(name[pos]))
+                continue;
+
+            // Find or create the directory of this path prefix..
+            const auto path = name.substr(0, pos);
+
+            auto slot = dravex::utils::hash_path(path) & this->dir_table_mask_;
+            while (this->dir_table_[slot] != 0 && !dravex::utils::equal_path(this->get_directory_path(this->dir_table_[slot] - 1), path))
+                slot = (slot + 1) & this->dir_table_mask_;
+
+            if (this->dir_table_[slot] == 0)
+            {
+                const auto index = this->dir_count_++;
+
+                this->dirs_[index]             = {parent, dravex::invalid_index, this->dirs_[parent].first_child_, dravex::invalid_index, 0, offset, static_cast<uint32_t>(pos)};
+                this->dirs_[parent].first_child_ = index;
+                this->dir_table_[slot]           = index + 1;
+            }
+
+            parent = this->dir_table_[slot] - 1;
+        }
+
+        // Link the entry into its directory..
+        this->entry_dirs_[x]             = parent;
+        this->entry_next_[x]             = this->dirs_[parent].first_entry_;
+        this->dirs_[parent].first_entry_ = x;
+        this->dirs_[parent].entry_count_++;
+    }
+
+    // Return the unused directory slots to the arena..
+    this->arena_.shrink(this->dirs_, sizeof(dravex::dirnode_t) * dir_limit, sizeof(dravex::dirnode_t) * this->dir_count_);
+
+    // Replace the verbatim names with the front-coded store when enabled..
+    if (this->compact_names_)
+        this->build_name_store();
+
+    // Make the lookup tables and directory tree (and compact named entries) visible to readers..
+    this->index_ready_.store(true, std::memory_order_release);
+    this->entries_ready_.store(this->entry_count_, std::memory_order_release);
+
+    dravex::stats::instance().add(dravex::counter::index_bytes, this->get_index_size());
+    DRAVEX_LOG(dravex::loglevel::info, "[parse]   -> index size: {} bytes ({} directories, {} arena block(s))", this->get_index_size(), this->dir_count_, this->arena_.get_block_count());
+
+    return this->report(dravex::openphase::build_lookup, 2, 2);
+}
+
+/**
+ * Builds the front-coded name store from the verbatim names and releases them.
+ *
+ * Directory paths are copied into the index arena first as they are referenced by the directory tree.
+ */
+void dravex::package::build_name_store(void)
+{
+    dravex::tracespan phase{"build names", "package"};
+
+    std::vector<std::string_view> names(this->entry_count_);
+    for (uint32_t x = 0; x < this->entry_count_; x++)
+        names[x] = to_view(this->get_string(this->entries_[x].string_offset_));
+
+    this->name_store_.build(names);
+
+    // Copy the directory paths into the index arena..
+    std::size_t size = 0;
+    for (uint32_t x = 0; x < this->dir_count_; x++)
+        size += this->dirs_[x].name_length_;
+
+    auto dir_names = this->arena_.allocate<char>(size + 1);
+
+    uint32_t offset = 0;
+    for (uint32_t x = 0; x < this->dir_count_; x++)
+    {
+        std::memcpy(dir_names + offset, this->names_ + this->dirs_[x].name_offset_, this->dirs_[x].name_length_);
+
+        this->dirs_[x].name_offset_ = offset;
+        offset += this->dirs_[x].name_length_;
+    }
+
+    this->dir_names_ = dir_names;
+
+    // Release the verbatim names..
+    this->names_arena_.reset();
+    this->names_      = nullptr;
+    this->names_size_ = 0;
+
+    const auto size_raw = this->name_store_.get_raw_size();
+    const auto size_fc  = this->name_store_.get_size();
+
+    dravex::stats::instance().add(dravex::counter::names_bytes, size_fc);
+    dravex::stats::instance().add(dravex::counter::names_raw_bytes, size_raw);
+    DRAVEX_LOG(dravex::loglevel::info, "[parse]   -> names: {} bytes front-coded, {} bytes verbatim ({:.1f}% saved)", size_fc, size_raw, size_raw == 0 ? 0.0 : 100.0 - static_cast<double>(size_fc) * 100.0 / static_cast<double>(size_raw));
+}
+
+/**
+ * Returns the name of the given entry as a view, decoding it into the scratch string if needed.
+ *
+ * @param {uint32_t} index - The entry index. (Must be valid.)
+ * @param {std::string&} scratch - The string to decode front-coded names into.
+ * @return {std::string_view} The entry name.
+ */
+std::string_view dravex::package::get_name_view(const uint32_t index, std::string& scratch)
+{
+    if (this->names_ != nullptr)
+        return to_view(this->get_string(this->entries_[index].string_offset_));
+
+    this->name_store_.get_name(index, scratch);
+    return scratch;
+}
 
 /**
  * Parses client version v118 package files.
@@ -47,70 +390,98 @@ dravex::package::~package(void)
  */
 bool dravex::package::parse_v118(std::shared_ptr<dravex::binarybuffer> buffer)
 {
-    dravex::logging::instance().log(dravex::loglevel::info, "[parse] detected 'v118' client archive..");
+    dravex::tracespan span{"package::parse_v118", "package"};
+
+    DRAVEX_LOG(dravex::loglevel::info, "[parse] detected 'v118' client archive..");
 
     // Read the header information..
-    const auto version             = buffer->read<uint32_t>();
-    this->guid_                    = buffer->read<std::vector<uint8_t>>(16);
+    const auto version = buffer->read<uint32_t>();
+    for (auto& b : this->guid_)
+        b = buffer->read<uint8_t>();
     const auto entry_count         = buffer->read<uint32_t>();
     const auto entry_offset        = buffer->read<uint32_t>();
     const auto string_table_size   = buffer->read<uint32_t>();
     const auto string_table_offset = buffer->read<uint32_t>();
 
-    dravex::logging::instance().log(dravex::loglevel::info, std::format("[parse]   -> entry count: {}", entry_count).c_str());
+    DRAVEX_LOG(dravex::loglevel::info, "[parse]   -> entry count: {}", entry_count);
 
     // Open the data file for reading..
     FILE* f = nullptr;
-    if (::fopen_s(&this->pkg_file_, this->pkg_path_.string().c_str(), "rb") != ERROR_SUCCESS)
+    if (::fopen_s(&this->pkg_file_, this->pkg_path_.string().c_str(), get_open_mode(this->access_)) != ERROR_SUCCESS)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] failed to open 'game.pkg' for reading; cannot continue..");
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to open 'game.pkg' for reading; cannot continue..");
         return false;
     }
 
     // Read and validate the game.pkg file GUID..
-    uint8_t data_guid[16]{};
-    if (::fread(data_guid, 1, 16, this->pkg_file_) != 16 || std::memcmp(this->guid_.data(), data_guid, 16) != 0)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] failed to validate 'game.pkg' guid; cannot continue..");
+        dravex::tracespan phase{"validate guid", "package"};
 
-        ::fclose(this->pkg_file_);
-        return false;
+        uint8_t data_guid[16]{};
+        if (::fread(data_guid, 1, 16, this->pkg_file_) != 16 || std::memcmp(this->guid_.data(), data_guid, 16) != 0)
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to validate 'game.pkg' guid; cannot continue..");
+            return false;
+        }
+
+        if (!this->report(dravex::openphase::validate_guid, 1, 1))
+            return false;
     }
 
-    // Read the file entries..
-    buffer->set_index(entry_offset);
-    const auto entries = buffer->read<std::vector<v118::diskpkgfileinfo_t>>(entry_count);
+    // Map the game.pkg file to serve uncompressed entries without copying them..
+    this->map_data();
 
-    // Read the string table information..
-    buffer->set_index(string_table_offset);
-    const auto string_table_data = buffer->read<std::vector<char>>(string_table_size);
+    // The v118 index is not compressed..
+    if (!this->report(dravex::openphase::inflate_index, 0, 0))
+        return false;
 
-    // Parse the string table..
-    dravex::utils::parse_strings(string_table_data, this->strings_);
-    if (this->strings_.size() != entry_count)
+    // Validate the string table location..
+    if (static_cast<uint64_t>(string_table_offset) + string_table_size > buffer->size())
     {
-        dravex::logging::instance().log(dravex::loglevel::error, std::format("[parse] invalid string count; cannot continue - got: {}, expected: {}", this->strings_.size(), entry_count).c_str());
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] invalid string table; cannot continue..");
         return false;
     }
 
-    // Convert the entries into generalized type..
-    for (auto x = 0; x < entry_count; x++)
+    const auto string_table = reinterpret_cast<const char*>(buffer->data()) + string_table_offset;
+    this->prepare_index(entry_count, string_table, string_table_size);
+
+    // Read the string table..
+    if (!this->build_names(string_table, string_table_size))
+        return false;
+
+    // Read the file entries, converting them into the generalized type..
     {
-        const auto& e           = entries[x];
-        auto obj                = std::make_shared<dravex::fileentry_t>();
-        obj->index_             = x;
-        obj->file_type_         = static_cast<uint32_t>(e.flags_) & 0x3F;
-        obj->string_offset_     = e.string_offset_;
-        obj->data_offset_       = e.data_offset_;
-        obj->size_compressed_   = e.size_compressed_;
-        obj->size_uncompressed_ = e.size_decompressed_;
-        obj->checksum_          = e.checksum_compressed_;
-        obj->is_compressed_     = (e.flags_ & 0x40) == 0x40;
+        dravex::tracespan phase{"build entries", "package"};
+
+        buffer->set_index(entry_offset);
+        for (uint32_t x = 0; x < entry_count; x++)
+        {
+            const auto e            = buffer->read<v118::diskpkgfileinfo_t>();
+            auto& obj               = this->entries_[x];
+            obj.index_              = x;
+            obj.file_type_          = static_cast<uint32_t>(e.flags_) & 0x3F;
+            obj.string_offset_      = e.string_offset_;
+            obj.data_offset_        = e.data_offset_;
+            obj.size_compressed_    = e.size_compressed_;
+            obj.size_uncompressed_  = e.size_decompressed_;
+            obj.checksum_           = e.checksum_compressed_;
+            obj.is_compressed_      = (e.flags_ & 0x40) == 0x40;
 
-        this->entries_.push_back(obj);
+            // Publish the entries built so far..
+            if ((x + 1) % publish_interval == 0)
+            {
+                this->publish_entries(x + 1);
+                if (!this->report(dravex::openphase::build_entries, x + 1, entry_count))
+                    return false;
+            }
+        }
+
+        this->publish_entries(entry_count);
+        if (!this->report(dravex::openphase::build_entries, entry_count, entry_count))
+            return false;
     }
 
-    return true;
+    return this->build_lookup();
 }
 
 /**
@@ -121,37 +492,59 @@ bool dravex::package::parse_v118(std::shared_ptr<dravex::binarybuffer> buffer)
  */
 bool dravex::package::parse_v666(std::shared_ptr<dravex::binarybuffer> buffer)
 {
-    dravex::logging::instance().log(dravex::loglevel::info, "[parse] detected 'v666' client archive..");
+    dravex::tracespan span{"package::parse_v666", "package"};
+
+    DRAVEX_LOG(dravex::loglevel::info, "[parse] detected 'v666' client archive..");
 
     // Read the uncompressed header information..
     const auto version1 = buffer->read<uint32_t>();
     const auto version2 = buffer->read<uint32_t>();
-    this->guid_         = buffer->read<std::vector<uint8_t>>(16);
+    for (auto& b : this->guid_)
+        b = buffer->read<uint8_t>();
 
     // Open the data file for reading..
     FILE* f = nullptr;
-    if (::fopen_s(&this->pkg_file_, this->pkg_path_.string().c_str(), "rb") != ERROR_SUCCESS)
+    if (::fopen_s(&this->pkg_file_, this->pkg_path_.string().c_str(), get_open_mode(this->access_)) != ERROR_SUCCESS)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] failed to open 'game.pkg' for reading; cannot continue..");
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to open 'game.pkg' for reading; cannot continue..");
         return false;
     }
 
     // Read and validate the game.pkg file GUID..
-    uint8_t data_guid[16]{};
-    if (::fread(data_guid, 1, 16, this->pkg_file_) != 16 || std::memcmp(this->guid_.data(), data_guid, 16) != 0)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] failed to validate 'game.pkg' guid; cannot continue..");
+        dravex::tracespan phase{"validate guid", "package"};
 
-        ::fclose(this->pkg_file_);
-        return false;
+        uint8_t data_guid[16]{};
+        if (::fread(data_guid, 1, 16, this->pkg_file_) != 16 || std::memcmp(this->guid_.data(), data_guid, 16) != 0)
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to validate 'game.pkg' guid; cannot continue..");
+            return false;
+        }
+
+        if (!this->report(dravex::openphase::validate_guid, 1, 1))
+            return false;
     }
 
+    // Map the game.pkg file to serve uncompressed entries without copying them..
+    this->map_data();
+
     // Decompress the remaining index data..
     std::vector<uint8_t> data_decompressed;
-    if (!dravex::utils::inflate(buffer->data(), buffer->size(), buffer->index(), data_decompressed))
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] failed to inflate remaining index data; cannot continue..");
-        return false;
+        dravex::tracespan phase{"inflate index", "package"};
+
+        const auto size = buffer->size() - buffer->index();
+        if (!this->report(dravex::openphase::inflate_index, 0, size))
+            return false;
+
+        if (!dravex::utils::inflate(buffer->data(), buffer->size(), buffer->index(), data_decompressed))
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to inflate remaining index data; cannot continue..");
+            return false;
+        }
+
+        if (!this->report(dravex::openphase::inflate_index, size, size))
+            return false;
     }
 
     // Set the binary buffer to the decompressed data..
@@ -165,23 +558,32 @@ bool dravex::package::parse_v666(std::shared_ptr<dravex::binarybuffer> buffer)
     // Calculate the total entry count..
     const auto entry_count = std::reduce(blocks.begin(), blocks.end());
 
-    dravex::logging::instance().log(dravex::loglevel::info, std::format("[parse]   -> entry count: {}", entry_count).c_str());
+    DRAVEX_LOG(dravex::loglevel::info, "[parse]   -> entry count: {}", entry_count);
 
-    // Read the file entries..
-    const auto entries = buffer->read<std::vector<v666::diskpkgfileinfo_t>>(entry_count);
+    // Locate the string table which follows the file entries..
+    const auto entry_offset      = buffer->index();
+    const auto string_size_index = entry_offset + static_cast<std::size_t>(entry_count) * sizeof(v666::diskpkgfileinfo_t);
+    if (string_size_index + sizeof(uint32_t) > buffer->size())
+    {
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] invalid string table; cannot continue..");
+        return false;
+    }
 
-    // Read the string table information..
+    buffer->set_index(string_size_index);
     const auto string_table_size = buffer->read<uint32_t>();
-    const auto string_table_data = buffer->read<std::vector<char>>(string_table_size);
-
-    // Parse the string table..
-    dravex::utils::parse_strings(string_table_data, this->strings_);
-    if (this->strings_.size() != entry_count)
+    if (buffer->index() + string_table_size > buffer->size())
     {
-        dravex::logging::instance().log(dravex::loglevel::error, std::format("[parse] invalid string count; cannot continue - got: {}, expected: {}", this->strings_.size(), entry_count).c_str());
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] invalid string table; cannot continue..");
         return false;
     }
 
+    const auto string_table = reinterpret_cast<const char*>(buffer->data()) + buffer->index();
+    this->prepare_index(entry_count, string_table, string_table_size);
+
+    // Read the string table..
+    if (!this->build_names(string_table, string_table_size))
+        return false;
+
     /**
      * Returns the file type for the given file index.
      *
@@ -189,43 +591,60 @@ bool dravex::package::parse_v666(std::shared_ptr<dravex::binarybuffer> buffer)
      * @return {uint32_t} The file type.
      */
     const auto get_file_type = [&blocks](const int32_t index) -> uint32_t {
-        for (auto x = 0, value = 0; x < blocks.size(); x++, value += blocks[x])
+        // Each block holds the number of files of its type, in index order..
+        uint32_t value = 0;
+        for (uint32_t x = 0; x < blocks.size(); x++)
         {
-            if (index < value)
+            value += blocks[x];
+            if (static_cast<uint32_t>(index) < value)
                 return x;
         }
         return 22;
     };
 
-    // Convert the entries into generalized type..
-    for (auto x = 0; x < entry_count; x++)
+    // Read the file entries, converting them into the generalized type..
     {
-        const auto& e           = entries[x];
-        auto obj                = std::make_shared<dravex::fileentry_t>();
-        obj->index_             = x;
-        obj->file_type_         = get_file_type(x);
-        obj->string_offset_     = e.string_offset_;
-        obj->data_offset_       = e.data_offset_;
-        obj->size_compressed_   = e.size_compressed_;
-        obj->size_uncompressed_ = e.size_decompressed_;
-        obj->checksum_          = e.checksum_;
-        obj->is_compressed_     = e.is_compressed_ > 0;
+        dravex::tracespan phase{"build entries", "package"};
+
+        buffer->set_index(entry_offset);
+        for (uint32_t x = 0; x < entry_count; x++)
+        {
+            const auto e            = buffer->read<v666::diskpkgfileinfo_t>();
+            auto& obj               = this->entries_[x];
+            obj.index_              = x;
+            obj.file_type_          = get_file_type(x);
+            obj.string_offset_      = e.string_offset_;
+            obj.data_offset_        = e.data_offset_;
+            obj.size_compressed_    = e.size_compressed_;
+            obj.size_uncompressed_  = e.size_decompressed_;
+            obj.checksum_           = e.checksum_;
+            obj.is_compressed_      = e.is_compressed_ > 0;
+
+            // Publish the entries built so far..
+            if ((x + 1) % publish_interval == 0)
+            {
+                this->publish_entries(x + 1);
+                if (!this->report(dravex::openphase::build_entries, x + 1, entry_count))
+                    return false;
+            }
+        }
 
-        this->entries_.push_back(obj);
+        this->publish_entries(entry_count);
+        if (!this->report(dravex::openphase::build_entries, entry_count, entry_count))
+            return false;
     }
 
-    return true;
+    return this->build_lookup();
 }
 
 /**
- * Returns the singleton instance of this class.
+ * Creates a new, closed package.
  *
- * @return {package&} The singleton instance of this class.
+ * @return {std::shared_ptr} The package handle.
  */
-dravex::package& dravex::package::instance(void)
+std::shared_ptr<dravex::package> dravex::package::create(void)
 {
-    static dravex::package pkg;
-    return pkg;
+    return std::make_shared<dravex::package>();
 }
 
 /**
@@ -245,17 +664,104 @@ const char* dravex::package::get_extension(const uint32_t file_type)
  * Opens and parses the given game assets archive.
  *
  * @param {std::string&} path - The path to the game.pki index file to open for parsing.
+ * @param {dravex::openprogressfn_t&} progress - The optional callback invoked with the progress of each phase.
  * @return {bool} True on success, false otherwise.
  */
-bool dravex::package::open(const std::string& path)
+bool dravex::package::open(const std::string& path, const dravex::openprogressfn_t& progress)
+{
+    this->close();
+
+    this->open_cancel_   = false;
+    this->open_progress_ = progress;
+
+    const auto ret = this->load(path);
+
+    this->open_progress_ = nullptr;
+
+    // Release any partially parsed index on failure..
+    if (!ret)
+        this->close();
+
+    return ret;
+}
+
+/**
+ * Opens and parses the given game assets archive on a background thread.
+ *
+ * Entries become available through get_entry_count and get_entry while the index is being built; the
+ * lookup tables and directory tree once it has finished. On failure, the partially parsed index is kept
+ * (but hidden) until the package is closed or opened again.
+ *
+ * @param {std::string&} path - The path to the game.pki index file to open for parsing.
+ * @param {dravex::openprogressfn_t&} progress - The optional callback invoked with the progress of each phase. (Background thread.)
+ */
+void dravex::package::open_async(const std::string& path, const dravex::openprogressfn_t& progress)
 {
     this->close();
 
+    this->open_cancel_   = false;
+    this->open_result_   = false;
+    this->opening_       = true;
+    this->open_progress_ = progress;
+    this->open_thread_   = std::thread([this, path]() {
+        dravex::tracing::instance().set_thread_name("package open");
+
+        this->open_result_   = this->load(path);
+        this->open_progress_ = nullptr;
+        this->opening_       = false;
+    });
+}
+
+/**
+ * Cancels a background open in progress, blocking until it has stopped.
+ */
+void dravex::package::cancel_open(void)
+{
+    this->open_cancel_ = true;
+
+    if (this->open_thread_.joinable())
+        this->open_thread_.join();
+
+    this->opening_ = false;
+}
+
+/**
+ * Blocks until a background open has finished.
+ *
+ * @return {bool} True if the package was opened successfully, false otherwise.
+ */
+bool dravex::package::wait_open(void)
+{
+    if (this->open_thread_.joinable())
+        this->open_thread_.join();
+
+    return this->open_result_;
+}
+
+/**
+ * Closes the current archive, cleaning up its resources. (Cancels a background open in progress.)
+ */
+void dravex::package::close(void)
+{
+    this->cancel_open();
+    this->release();
+}
+
+/**
+ * Opens and parses the given game assets archive. (Invoked by open and open_async.)
+ *
+ * @param {std::string&} path - The path to the game.pki index file to open for parsing.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::package::load(const std::string& path)
+{
+    dravex::tracespan span{"package::open", "package"};
+
     std::error_code ec{};
     std::filesystem::path pki_path = path;
     if (!std::filesystem::exists(pki_path, ec) || ec)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] invalid 'game.pki' path; cannot continue..");
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] invalid 'game.pki' path; cannot continue..");
         return false;
     }
 
@@ -264,61 +770,107 @@ bool dravex::package::open(const std::string& path)
 
     if (!std::filesystem::exists(pkg_path, ec) || ec)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] invalid 'game.pkg' path; cannot continue..");
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] invalid 'game.pkg' path; cannot continue..");
         return false;
     }
 
     this->pki_path_ = pki_path;
     this->pkg_path_ = pkg_path;
 
-    dravex::logging::instance().log(dravex::loglevel::info, std::format("[parse] opening archive for parsing: {}", this->pki_path_.string()).c_str());
+    DRAVEX_LOG(dravex::loglevel::info, "[parse] opening archive for parsing: {}", this->pki_path_.string());
 
     // Open the index file for reading..
     FILE* f = nullptr;
     if (::fopen_s(&f, pki_path.string().c_str(), "rb") != ERROR_SUCCESS)
     {
-        dravex::logging::instance().log(dravex::loglevel::error, "[parse] failed to open 'game.pki' for reading; cannot continue..");
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to open 'game.pki' for reading; cannot continue..");
         return false;
     }
 
     // Obtain the index file size..
-    ::fseek(f, 0, SEEK_END);
+    ::_fseeki64(f, 0, SEEK_END);
     const auto size = ::_ftelli64(f);
-    ::fseek(f, 0, SEEK_SET);
+    if (size < 0 || ::_fseeki64(f, 0, SEEK_SET) != 0)
+    {
+        ::fclose(f);
+
+        DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to obtain the 'game.pki' file size; cannot continue..");
+        return false;
+    }
+
+    // Read the index file data, in chunks to report the progress..
+    std::vector<uint8_t> data(static_cast<std::size_t>(size), '\0');
+    {
+        dravex::tracespan phase{"read pki", "package"};
+
+        std::size_t offset = 0;
+        while (offset < data.size())
+        {
+            const auto chunk = std::min<std::size_t>(data.size() - offset, 1024 * 1024);
+            if (::fread(data.data() + offset, 1, chunk, f) != chunk)
+            {
+                ::fclose(f);
+
+                DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to read 'game.pki' file data; cannot continue..");
+                return false;
+            }
+
+            offset += chunk;
+
+            if (!this->report(dravex::openphase::read_pki, offset, data.size()))
+            {
+                ::fclose(f);
+                return false;
+            }
+        }
 
-    // Read the index file data..
-    std::vector<uint8_t> data(size, '\0');
-    ::fread(data.data(), 1, size, f);
-    ::fclose(f);
+        ::fclose(f);
+    }
 
     // Create a binary buffer to parse the file data..
     auto buffer = std::make_shared<dravex::binarybuffer>(data.data(), data.size());
 
     // Handle the file based on the version..
+    auto ret           = false;
     const auto version = buffer->read<uint32_t>();
+    this->version_     = version;
     switch (version)
     {
         case 2: // Client Version: v118
             buffer->reset();
-            return this->parse_v118(buffer);
+            ret = this->parse_v118(buffer);
+            break;
 
         case 3: // Client Version: v666
             buffer->reset();
-            return this->parse_v666(buffer);
+            ret = this->parse_v666(buffer);
+            break;
 
         default:
+            DRAVEX_LOG(dravex::loglevel::error, "[parse] unsupported 'game.pki' version, cannot parse.. - version: {}", version);
             break;
     }
 
-    dravex::logging::instance().log(dravex::loglevel::error, std::format("[parse] unsupported 'game.pki' version, cannot parse.. - version: {}", version).c_str());
+    if (!ret)
+    {
+        // Hide any entries published before the failure..
+        this->entries_ready_.store(0, std::memory_order_release);
+        this->index_ready_.store(false, std::memory_order_release);
+
+        if (this->open_cancel_)
+            DRAVEX_LOG(dravex::loglevel::info, "[parse] opening archive was cancelled..");
+
+        return false;
+    }
 
-    return false;
+    this->report(dravex::openphase::count, 1, 1);
+    return true;
 }
 
 /**
- * Closes the current archive, cleaning up its resources.
+ * Releases the resources of the current archive.
  */
-void dravex::package::close(void)
+void dravex::package::release(void)
 {
     if (this->pkg_file_ != nullptr)
     {
@@ -326,80 +878,823 @@ void dravex::package::close(void)
         this->pkg_file_ = nullptr;
     }
 
+    // Release the game.pkg mapping..
+    if (this->pkg_view_ != nullptr)
+        ::UnmapViewOfFile(this->pkg_view_);
+    if (this->pkg_mapping_ != nullptr)
+        ::CloseHandle(this->pkg_mapping_);
+    if (this->pkg_handle_ != INVALID_HANDLE_VALUE)
+        ::CloseHandle(this->pkg_handle_);
+
+    this->pkg_handle_  = INVALID_HANDLE_VALUE;
+    this->pkg_mapping_ = nullptr;
+    this->pkg_view_    = nullptr;
+    this->pkg_size_    = 0;
+
     this->pki_path_.clear();
     this->pkg_path_.clear();
-    this->guid_.clear();
-    this->entries_.clear();
-    this->strings_.clear();
-}
+    this->guid_.fill(0);
+    this->version_ = 0;
+    this->cache_.clear();
 
-/**
- * Returns the count of parsed file entries.
- *
- * @return {std::size_t} The count of file entries.
- */
-std::size_t dravex::package::get_entry_count(void)
-{
-    return this->entries_.size();
+    {
+        std::lock_guard<std::mutex> lock{this->access_mutex_};
+        this->access_indexes_.clear();
+        this->access_lru_.clear();
+        this->access_bytes_ = 0;
+    }
+
+    // Release the index..
+    this->entries_ready_.store(0, std::memory_order_release);
+    this->index_ready_.store(false, std::memory_order_release);
+
+    this->arena_.reset();
+    this->entries_          = nullptr;
+    this->entry_count_      = 0;
+    this->names_            = nullptr;
+    this->names_size_       = 0;
+    this->entry_table_      = nullptr;
+    this->entry_table_mask_ = 0;
+    this->entry_dirs_       = nullptr;
+    this->entry_next_       = nullptr;
+    this->dirs_             = nullptr;
+    this->dir_count_        = 0;
+    this->dir_table_        = nullptr;
+    this->dir_table_mask_   = 0;
+    this->dir_names_        = nullptr;
+
+    this->names_arena_.reset();
+    this->name_store_.clear();
+
+    this->open_phase_ = static_cast<uint32_t>(dravex::openphase::count);
+    this->open_done_  = 0;
+    this->open_total_ = 0;
 }
 
 /**
- * Returns the file entry at the given index.
+ * Maps the game.pkg file into memory, read-only.
  *
- * @param {int32_t} index - The index of the file entry to return.
- * @return {std::shared_ptr} The file entry.
+ * Failing to map the file is not an error; uncompressed entries are then only served through read_entry.
  */
-std::shared_ptr<dravex::fileentry_t> dravex::package::get_entry(const int32_t index)
+void dravex::package::map_data(void)
 {
-    return (this->entries_.size() == 0 || index >= this->entries_.size() || index == -1)
-               ? nullptr
-               : this->entries_[index];
-}
+    auto flags = FILE_ATTRIBUTE_NORMAL;
+    if (this->access_ == dravex::accesspattern::sequential)
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    else if (this->access_ == dravex::accesspattern::random)
+        flags |= FILE_FLAG_RANDOM_ACCESS;
 
-/**
- * Returns the data for the given file entry.
+    this->pkg_handle_ = ::CreateFileA(this->pkg_path_.string().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (this->pkg_handle_ == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(this->pkg_handle_, &size) || size.QuadPart == 0)
+        return;
+
+    this->pkg_mapping_ = ::CreateFileMappingA(this->pkg_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (this->pkg_mapping_ == nullptr)
+        return;
+
+    this->pkg_view_ = static_cast<const uint8_t*>(::MapViewOfFile(this->pkg_mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (this->pkg_view_ == nullptr)
+    {
+        DRAVEX_LOG(dravex::loglevel::debug, "[parse] failed to map 'game.pkg'; zero-copy reads are disabled..");
+        return;
+    }
+
+    this->pkg_size_ = static_cast<uint64_t>(size.QuadPart);
+
+    // Populate the mapping for repeated random access.. (Large pages are not available for file mappings.)
+    if (this->access_ == dravex::accesspattern::random)
+    {
+        dravex::tracespan phase{"populate", "package"};
+
+        WIN32_MEMORY_RANGE_ENTRY range{const_cast<uint8_t*>(this->pkg_view_), static_cast<SIZE_T>(this->pkg_size_)};
+        if (!::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0))
+            DRAVEX_LOG(dravex::loglevel::debug, "[parse] failed to prefetch the 'game.pkg' mapping..");
+    }
+}
+
+/**
+ * Updates the progress of opening the archive.
+ *
+ * @param {dravex::openphase} phase - The current phase.
+ * @param {uint64_t} done - The amount of work done within the phase.
+ * @param {uint64_t} total - The total amount of work of the phase.
+ * @return {bool} True to continue opening, false if the open was cancelled.
+ */
+bool dravex::package::report(const dravex::openphase phase, const uint64_t done, const uint64_t total)
+{
+    this->open_phase_ = static_cast<uint32_t>(phase);
+    this->open_done_  = done;
+    this->open_total_ = total;
+
+    if (this->open_progress_)
+        this->open_progress_({phase, done, total});
+
+    return !this->open_cancel_;
+}
+
+/**
+ * Returns if the archive is being opened in the background.
+ *
+ * @return {bool} True if opening, false otherwise.
+ */
+bool dravex::package::is_opening(void) const
+{
+    return this->opening_;
+}
+
+/**
+ * Returns the progress of opening the archive.
+ *
+ * @return {dravex::openprogress_t} The open progress.
+ */
+dravex::openprogress_t dravex::package::get_open_progress(void) const
+{
+    return {static_cast<dravex::openphase>(this->open_phase_.load()), this->open_done_.load(), this->open_total_.load()};
+}
+
+/**
+ * Returns the display name of the given open phase.
+ *
+ * @param {dravex::openphase} phase - The open phase.
+ * @return {const char*} The phase name.
+ */
+const char* dravex::package::get_phase_name(const dravex::openphase phase)
+{
+    switch (phase)
+    {
+        case dravex::openphase::read_pki:
+            return "Reading Index";
+        case dravex::openphase::validate_guid:
+            return "Validating GUID";
+        case dravex::openphase::inflate_index:
+            return "Inflating Index";
+        case dravex::openphase::parse_strings:
+            return "Parsing Names";
+        case dravex::openphase::build_entries:
+            return "Building Entries";
+        case dravex::openphase::build_lookup:
+            return "Building Lookup";
+        case dravex::openphase::count:
+            break;
+    }
+
+    return "Done";
+}
+
+/**
+ * Returns the display name of the given access pattern.
+ *
+ * @param {dravex::accesspattern} pattern - The access pattern.
+ * @return {const char*} The access pattern name.
+ */
+const char* dravex::package::get_access_pattern_name(const dravex::accesspattern pattern)
+{
+    switch (pattern)
+    {
+        case dravex::accesspattern::normal:
+            return "normal";
+        case dravex::accesspattern::sequential:
+            return "sequential";
+        case dravex::accesspattern::random:
+            return "random";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Returns the count of parsed file entries.
+ *
+ * @return {std::size_t} The count of file entries.
+ */
+std::size_t dravex::package::get_entry_count(void)
+{
+    return this->entries_ready_.load(std::memory_order_acquire);
+}
+
+/**
+ * Returns the file entry at the given index.
+ *
+ * The returned entry is owned by the package index and remains valid until the package is closed.
+ *
+ * @param {int32_t} index - The index of the file entry to return.
+ * @return {dravex::fileentry_t*} The file entry on success, nullptr otherwise.
+ */
+const dravex::fileentry_t* dravex::package::get_entry(const int32_t index)
+{
+    return (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire))
+               ? nullptr
+               : &this->entries_[index];
+}
+
+/**
+ * Returns the index of the entry with the given path. (Case and separator insensitive.)
+ *
+ * @param {std::string_view} path - The path of the entry to find.
+ * @return {int32_t} The entry index on success, -1 otherwise.
+ */
+int32_t dravex::package::find_entry(const std::string_view path)
+{
+    if (!this->index_ready_.load(std::memory_order_acquire))
+        return -1;
+
+    thread_local std::string scratch;
+
+    auto slot = dravex::utils::hash_path(path) & this->entry_table_mask_;
+    while (this->entry_table_[slot] != 0)
+    {
+        const auto index = this->entry_table_[slot] - 1;
+        if (dravex::utils::equal_path(this->get_name_view(index, scratch), path))
+            return static_cast<int32_t>(index);
+
+        slot = (slot + 1) & this->entry_table_mask_;
+    }
+
+    return -1;
+}
+
+/**
+ * Reads the data for the given file entry into the given buffer.
+ *
+ * The compressed input is read into a pooled scratch buffer and inflated directly into the output buffer.
+ * With the random access pattern the input is instead inflated straight from the populated mapping.
+ * Reusing the same output buffer across calls avoids all heap allocations once it has grown large enough.
  *
  * @param {int32_t} index - The file index to obtain the data of.
- * @return {std::vector} The file data.
+ * @param {T&} output - The buffer to hold the file data. (Replaced.)
+ * @return {bool} True on success, false otherwise.
  */
-std::vector<uint8_t> dravex::package::get_entry_data(const int32_t index)
+template<typename T>
+bool dravex::package::read_entry_into(const int32_t index, T& output)
 {
-    if (this->entries_.size() == 0 || index >= this->entries_.size() || index == -1)
-        return {};
+    output.clear();
+
+    if (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire))
+        return false;
 
-    const auto e = this->entries_[index];
+    dravex::tracespan span{"package::read_entry", "package", index};
+
+    const auto e = &this->entries_[index];
     auto size    = e->is_compressed_ ? e->size_compressed_ : e->size_uncompressed_;
 
+    auto& stats = dravex::stats::instance();
+
+    // Read from the populated mapping for random access; without taking the file lock or a scratch copy..
+    const auto mapped = this->access_ == dravex::accesspattern::random && this->pkg_view_ != nullptr && static_cast<uint64_t>(e->data_offset_) + size <= this->pkg_size_;
+
+    // Read uncompressed data straight into the output buffer..
+    dravex::pooledbuffer scratch{e->is_compressed_ && !mapped ? size : 0};
+    if (!e->is_compressed_)
+        output.resize(size);
+
+    const auto data = e->is_compressed_ ? scratch.get().data() : output.data();
+
     // Read the file data from the game.pkg file..
-    std::vector<uint8_t> data(size, '\0');
-    ::fseek(this->pkg_file_, e->data_offset_, SEEK_SET);
-    ::fread(data.data(), size, 1, this->pkg_file_);
+    if (!mapped || !e->is_compressed_)
+    {
+        dravex::scopedtimer timer{dravex::stage::read};
+        dravex::tracespan phase{"read", "package", index};
+
+        if (mapped)
+            std::memcpy(data, this->pkg_view_ + e->data_offset_, size);
+        else
+        {
+            // The seek and read must happen together as the file handle is shared between threads..
+            std::lock_guard<std::mutex> lock{this->pkg_mutex_};
+
+            // Fail on a short read, ie. a truncated game.pkg file, instead of returning stale buffer contents..
+            if (::_fseeki64(this->pkg_file_, static_cast<int64_t>(e->data_offset_), SEEK_SET) != 0 || ::fread(data, 1, size, this->pkg_file_) != size)
+            {
+                DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to read entry data, entry index: {}", index);
+
+                output.clear();
+                return false;
+            }
+        }
+    }
+
+    stats.add(dravex::counter::bytes_read, size);
 
     // Return the raw data if it is not compressed..
     if (!e->is_compressed_)
-        return data;
+    {
+        stats.add(dravex::counter::entries_served, 1);
+        return true;
+    }
+
+    const auto input = mapped ? this->pkg_view_ + e->data_offset_ : data;
 
     // Inflate the data via zlib..
-    std::vector<uint8_t> data_decompressed;
-    if (!dravex::utils::inflate(data.data(), data.size(), 0, data_decompressed))
     {
-        dravex::logging::instance().log(dravex::loglevel::error, std::format("[parse] failed to inflate compressed entry data, entry index: {}", index).c_str());
+        dravex::scopedtimer timer{dravex::stage::inflate};
+        dravex::tracespan phase{"inflate", "package", index};
+
+        output.reserve(e->size_uncompressed_);
+        if (!dravex::utils::inflate(input, size, 0, output))
+        {
+            DRAVEX_LOG(dravex::loglevel::error, "[parse] failed to inflate compressed entry data, entry index: {}", index);
+            return false;
+        }
+    }
+
+    stats.add(dravex::counter::bytes_inflated, output.size());
+    stats.add(dravex::counter::entries_served, 1);
+
+    return true;
+}
+
+/**
+ * Reads the data for the given file entry into the given buffer.
+ *
+ * @param {int32_t} index - The file index to obtain the data of.
+ * @param {std::vector&} output - The buffer to hold the file data. (Replaced.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::package::read_entry(const int32_t index, std::vector<uint8_t>& output)
+{
+    return this->read_entry_into(index, output);
+}
+
+/**
+ * Reads the data for the given file entry into the given pooled buffer. (Grown without zeroing it first.)
+ *
+ * @param {int32_t} index - The file index to obtain the data of.
+ * @param {dravex::bytebuffer_t&} output - The buffer to hold the file data. (Replaced.)
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::package::read_entry(const int32_t index, dravex::bytebuffer_t& output)
+{
+    return this->read_entry_into(index, output);
+}
+
+/**
+ * Reads part of the stored data of the given file entry, as held within the game.pkg file. (Compressed entries are not inflated.)
+ *
+ * @param {int32_t} index - The file index to read the data of.
+ * @param {uint32_t} offset - The offset within the stored data to read from.
+ * @param {uint8_t*} output - The buffer to hold the data.
+ * @param {uint32_t} size - The number of bytes to read.
+ * @return {uint32_t} The number of bytes read. (Less than requested at the end of the stored data.)
+ */
+uint32_t dravex::package::read_entry_raw(const int32_t index, const uint32_t offset, uint8_t* output, const uint32_t size)
+{
+    if (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire))
+        return 0;
+
+    const auto e      = &this->entries_[index];
+    const auto stored = e->is_compressed_ ? e->size_compressed_ : e->size_uncompressed_;
+    if (offset >= stored)
+        return 0;
+
+    const auto count = std::min(size, stored - offset);
+    const auto start = static_cast<uint64_t>(e->data_offset_) + offset;
+
+    {
+        dravex::scopedtimer timer{dravex::stage::read};
+
+        // Copy from the mapping when available; otherwise the seek and read must happen together as the file handle is shared between threads..
+        if (this->pkg_view_ != nullptr && start + count <= this->pkg_size_)
+            std::memcpy(output, this->pkg_view_ + start, count);
+        else
+        {
+            std::lock_guard<std::mutex> lock{this->pkg_mutex_};
+
+            if (::_fseeki64(this->pkg_file_, static_cast<int64_t>(start), SEEK_SET) != 0 || ::fread(output, 1, count, this->pkg_file_) != count)
+                return 0;
+        }
+    }
+
+    dravex::stats::instance().add(dravex::counter::bytes_read, count);
+    return count;
+}
+
+/**
+ * Returns the data for the given file entry.
+ *
+ * @param {int32_t} index - The file index to obtain the data of.
+ * @return {std::vector} The file data.
+ */
+std::vector<uint8_t> dravex::package::get_entry_data(const int32_t index)
+{
+    std::vector<uint8_t> data;
+    if (!this->read_entry(index, data))
         return {};
+
+    return data;
+}
+
+/**
+ * Returns the data for the given file entry, served from the entry cache when possible.
+ *
+ * The returned buffer is shared with the cache and remains valid for as long as the caller holds it.
+ *
+ * @param {int32_t} index - The file index to obtain the data of.
+ * @return {dravex::entrybuffer_t} The file data on success, nullptr otherwise.
+ */
+dravex::entrybuffer_t dravex::package::get_entry_buffer(const int32_t index)
+{
+    if (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire))
+        return nullptr;
+
+    // Return the cached data if available..
+    auto buffer = this->cache_.get(index);
+    if (buffer != nullptr)
+    {
+        dravex::stats::instance().add(dravex::counter::entries_served, 1);
+        return buffer;
     }
 
-    return data_decompressed;
+    // Read the data and cache it..
+    dravex::bytebuffer_t data;
+    if (!this->read_entry(index, data))
+        return nullptr;
+
+    buffer = std::make_shared<const dravex::bytebuffer_t>(std::move(data));
+    this->cache_.put(index, buffer);
+
+    return buffer;
+}
+
+/**
+ * Returns a view of the stored data of the given uncompressed entry within the mapped game.pkg file.
+ *
+ * The view lets the data be written out without first copying it into a buffer. It remains valid until the
+ * package is closed. Compressed entries must be read with read_entry instead.
+ *
+ * @param {int32_t} index - The file index to obtain the view of.
+ * @param {dravex::entryview_t&} view - The view of the entry data.
+ * @return {bool} True on success, false otherwise. (Compressed entry, or the package could not be mapped.)
+ */
+bool dravex::package::get_entry_view(const int32_t index, dravex::entryview_t& view)
+{
+    if (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire))
+        return false;
+
+    const auto e = &this->entries_[index];
+    if (e->is_compressed_ || this->pkg_view_ == nullptr)
+        return false;
+
+    if (static_cast<uint64_t>(e->data_offset_) + e->size_uncompressed_ > this->pkg_size_)
+        return false;
+
+    view.data_      = this->pkg_view_ + e->data_offset_;
+    view.size_      = e->size_uncompressed_;
+    view.file_      = this->pkg_handle_;
+    view.offset_    = e->data_offset_;
+    view.file_size_ = this->pkg_size_;
+
+    dravex::stats::instance().add(dravex::counter::entries_served, 1);
+    return true;
+}
+
+/**
+ * Releases a view obtained from get_entry_view once its data has been used.
+ *
+ * With the sequential access pattern the pages of the view are removed from the working set, so a single
+ * pass over the package does not grow it; the pages are then the first to be reused by the system.
+ *
+ * @param {dravex::entryview_t&} view - The view to release.
+ */
+void dravex::package::release_entry_view(const dravex::entryview_t& view)
+{
+    if (this->access_ != dravex::accesspattern::sequential || view.data_ == nullptr || view.size_ == 0)
+        return;
+
+    // Unlocking pages that are not locked removes them from the working set..
+    ::VirtualUnlock(const_cast<uint8_t*>(view.data_), view.size_);
+}
+
+/**
+ * Returns the access points of the given entry.
+ *
+ * @param {int32_t} index - The file index to obtain the access points of.
+ * @return {dravex::accessindexptr_t} The access points if built, nullptr otherwise.
+ */
+dravex::accessindexptr_t dravex::package::get_access_index(const int32_t index)
+{
+    std::lock_guard<std::mutex> lock{this->access_mutex_};
+
+    const auto iter = this->access_indexes_.find(static_cast<uint32_t>(index));
+    if (iter == this->access_indexes_.end())
+        return nullptr;
+
+    // Mark the access points as the most recently used..
+    this->access_lru_.splice(this->access_lru_.begin(), this->access_lru_, iter->second);
+    return std::get<1>(*iter->second);
+}
+
+/**
+ * Sets the access points of the given entry.
+ *
+ * The access points are kept until the package is closed, or until they are the least recently used once
+ * the stored access points exceed the access budget.
+ *
+ * @param {int32_t} index - The file index the access points belong to.
+ * @param {dravex::accessindexptr_t&} access - The access points.
+ */
+void dravex::package::set_access_index(const int32_t index, const dravex::accessindexptr_t& access)
+{
+    if (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire) || access == nullptr)
+        return;
+
+    dravex::stats::instance().add(dravex::counter::access_points, access->points_.size());
+
+    std::lock_guard<std::mutex> lock{this->access_mutex_};
+
+    const auto iter = this->access_indexes_.find(static_cast<uint32_t>(index));
+    if (iter != this->access_indexes_.end())
+    {
+        this->access_bytes_ -= std::get<1>(*iter->second)->size_;
+        this->access_lru_.erase(iter->second);
+    }
+
+    this->access_lru_.emplace_front(static_cast<uint32_t>(index), access);
+    this->access_indexes_[static_cast<uint32_t>(index)] = this->access_lru_.begin();
+    this->access_bytes_ += access->size_;
+
+    // Evict the least recently used access points over the budget..
+    while (this->access_bytes_ > this->access_budget_ && !this->access_lru_.empty())
+    {
+        const auto& [idx, points] = this->access_lru_.back();
+
+        this->access_bytes_ -= points->size_;
+        this->access_indexes_.erase(idx);
+        this->access_lru_.pop_back();
+    }
 }
 
 /**
  * Returns the string that starts at the given table offset.
- * 
+ *
+ * Only available while the verbatim names are held; use get_entry_name when compact names are enabled.
+ *
  * @param {uint32_t} offset - The string table offset of the string to return.
  * @return {const char*} The string on success, nullptr otherwise.
  */
 const char* dravex::package::get_string(const uint32_t offset)
 {
-    const auto iter = this->strings_.find(offset);
-    return iter == this->strings_.end()
+    if (this->names_ == nullptr || offset >= this->names_size_)
+        return nullptr;
+
+    // Only offsets at the start of a string are valid..
+    if (offset > 0 && this->names_[offset - 1] != '\0')
+        return nullptr;
+
+    return this->names_ + offset;
+}
+
+/**
+ * Obtains the name of the given entry. (Works with both verbatim and compact names.)
+ *
+ * @param {int32_t} index - The entry index.
+ * @param {std::string&} output - The string to hold the entry name.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::package::get_entry_name(const int32_t index, std::string& output)
+{
+    output.clear();
+
+    if (index < 0 || static_cast<uint32_t>(index) >= this->entries_ready_.load(std::memory_order_acquire))
+        return false;
+
+    if (this->names_ == nullptr)
+        return this->name_store_.get_name(static_cast<uint32_t>(index), output);
+
+    const auto name = this->get_string(this->entries_[index].string_offset_);
+    if (name == nullptr)
+        return false;
+
+    output.assign(name);
+    return true;
+}
+
+/**
+ * Invokes the given function for every entry in name order.
+ *
+ * Compact names are already sorted and are decoded incrementally; verbatim names are sorted on each call.
+ *
+ * @param {std::function} func - The function to invoke with the entry index and name. Returns false to stop iterating.
+ */
+void dravex::package::for_each_sorted_entry(const std::function<bool(uint32_t, std::string_view)>& func)
+{
+    if (!this->index_ready_.load(std::memory_order_acquire))
+        return;
+
+    if (this->names_ == nullptr)
+    {
+        this->name_store_.for_each(func);
+        return;
+    }
+
+    std::vector<uint32_t> order(this->entry_count_);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [this](const uint32_t a, const uint32_t b) {
+        return to_view(this->get_string(this->entries_[a].string_offset_)) < to_view(this->get_string(this->entries_[b].string_offset_));
+    });
+
+    for (const auto index : order)
+    {
+        if (!func(index, to_view(this->get_string(this->entries_[index].string_offset_))))
+            return;
+    }
+}
+
+/**
+ * Returns the count of directories in the package directory tree. (Including the root directory.)
+ *
+ * @return {std::size_t} The count of directories.
+ */
+std::size_t dravex::package::get_directory_count(void)
+{
+    return this->index_ready_.load(std::memory_order_acquire) ? this->dir_count_ : 0;
+}
+
+/**
+ * Returns the directory at the given index.
+ *
+ * @param {uint32_t} index - The index of the directory to return.
+ * @return {dravex::dirnode_t*} The directory on success, nullptr otherwise.
+ */
+const dravex::dirnode_t* dravex::package::get_directory(const uint32_t index)
+{
+    return index >= this->get_directory_count()
                ? nullptr
-               : iter->second.c_str();
+               : &this->dirs_[index];
+}
+
+/**
+ * Returns the full path of the directory at the given index.
+ *
+ * @param {uint32_t} index - The index of the directory.
+ * @return {std::string_view} The directory path, empty for the root directory.
+ */
+std::string_view dravex::package::get_directory_path(const uint32_t index)
+{
+    if (index >= this->dir_count_ || this->dirs_[index].name_length_ == 0)
+        return {};
+
+    return std::string_view{this->dir_names_ + this->dirs_[index].name_offset_, this->dirs_[index].name_length_};
+}
+
+/**
+ * Returns the index of the directory holding the given entry.
+ *
+ * @param {int32_t} index - The entry index.
+ * @return {uint32_t} The directory index on success, invalid_index otherwise.
+ */
+uint32_t dravex::package::get_entry_directory(const int32_t index)
+{
+    return (index < 0 || !this->index_ready_.load(std::memory_order_acquire) || static_cast<uint32_t>(index) >= this->entry_count_)
+               ? dravex::invalid_index
+               : this->entry_dirs_[index];
+}
+
+/**
+ * Returns the index of the next entry within the same directory as the given entry.
+ *
+ * Used with dirnode_t::first_entry_ to walk the entries of a directory.
+ *
+ * @param {int32_t} index - The entry index.
+ * @return {uint32_t} The next entry index, invalid_index if there are no more entries.
+ */
+uint32_t dravex::package::get_next_directory_entry(const int32_t index)
+{
+    return (index < 0 || !this->index_ready_.load(std::memory_order_acquire) || static_cast<uint32_t>(index) >= this->entry_count_)
+               ? dravex::invalid_index
+               : this->entry_next_[index];
+}
+
+/**
+ * Returns the version of the opened index file.
+ *
+ * @return {uint32_t} The index file version. (2 for v118, 3 for v666, 0 if no package is open.)
+ */
+uint32_t dravex::package::get_version(void) const
+{
+    return this->version_;
+}
+
+/**
+ * Returns the exact memory footprint of the parsed index. (Entries, names, lookup tables and directory tree.)
+ *
+ * @return {std::size_t} The index size in bytes.
+ */
+std::size_t dravex::package::get_index_size(void)
+{
+    if (!this->index_ready_.load(std::memory_order_acquire))
+        return 0;
+
+    return this->arena_.get_used() + this->names_arena_.get_used() + this->name_store_.get_size();
+}
+
+/**
+ * Returns if entry names are stored front-coded.
+ *
+ * @return {bool} True if enabled, false otherwise.
+ */
+bool dravex::package::get_compact_names(void) const
+{
+    return this->compact_names_;
+}
+
+/**
+ * Sets if entry names are stored front-coded. (Applies to the next opened package.)
+ *
+ * Front-coded names use a fraction of the memory of the verbatim string table, at the cost of decoding
+ * names on access. get_string is unavailable while enabled.
+ *
+ * @param {bool} enabled - The enabled state.
+ */
+void dravex::package::set_compact_names(const bool enabled)
+{
+    this->compact_names_ = enabled;
+}
+
+/**
+ * Returns the spacing of the access points built into large compressed entries.
+ *
+ * @return {uint32_t} The uncompressed bytes between access points; 0 when disabled.
+ */
+uint32_t dravex::package::get_access_span(void) const
+{
+    return this->access_span_;
+}
+
+/**
+ * Sets the spacing of the access points built into large compressed entries. (Applies to entries read after.)
+ *
+ * Entries at least two spans large get access points built by the first entryreader that reads them in
+ * full. Each access point holds a 32KB window, so smaller spans trade memory for shorter seeks; the stored
+ * access points are bounded by the access budget.
+ *
+ * @param {uint32_t} span - The uncompressed bytes between access points; 0 to disable.
+ */
+void dravex::package::set_access_span(const uint32_t span)
+{
+    this->access_span_ = span;
+}
+
+/**
+ * Returns the memory budget of the stored access points.
+ *
+ * @return {uint64_t} The budget in bytes.
+ */
+uint64_t dravex::package::get_access_budget(void) const
+{
+    return this->access_budget_;
+}
+
+/**
+ * Sets the memory budget of the stored access points. (Applies to access points stored after.)
+ *
+ * @param {uint64_t} budget - The budget in bytes.
+ */
+void dravex::package::set_access_budget(const uint64_t budget)
+{
+    std::lock_guard<std::mutex> lock{this->access_mutex_};
+    this->access_budget_ = budget;
+}
+
+/**
+ * Returns the access pattern hinted when reading the game.pkg file.
+ *
+ * @return {dravex::accesspattern} The access pattern.
+ */
+dravex::accesspattern dravex::package::get_access_pattern(void) const
+{
+    return this->access_;
+}
+
+/**
+ * Sets the access pattern hinted when reading the game.pkg file. (Applies to the next opened package.)
+ *
+ * @param {dravex::accesspattern} pattern - The access pattern.
+ */
+void dravex::package::set_access_pattern(const dravex::accesspattern pattern)
+{
+    this->access_ = pattern;
+}
+
+/**
+ * Returns the front-coded name store of the package. (Empty unless compact names are enabled.)
+ *
+ * @return {dravex::namestore&} The name store.
+ */
+const dravex::namestore& dravex::package::get_name_store(void) const
+{
+    return this->name_store_;
+}
+
+/**
+ * Returns the decompressed entry cache of the package.
+ *
+ * @return {dravex::entrycache&} The entry cache.
+ */
+dravex::entrycache& dravex::package::get_cache(void)
+{
+    return this->cache_;
 }
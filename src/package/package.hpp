@@ -32,7 +32,11 @@
 #endif
 
 #include "../defines.hpp"
+#include "../arena.hpp"
 #include "../binarybuffer.hpp"
+#include "../bufferpool.hpp"
+#include "cache.hpp"
+#include "namestore.hpp"
 
 namespace dravex
 {
@@ -55,6 +59,115 @@ namespace dravex
         bool is_compressed_;
     };
 
+    /**
+     * Value used for invalid entry and directory indexes.
+     */
+    constexpr uint32_t invalid_index = 0xFFFFFFFF;
+
+    /**
+     * Structure definition for a directory of the package directory tree.
+     *
+     * Directory names are not stored separately; a directory refers to the leading part of the name of one of
+     * the entries it holds. The root directory is always index 0 and has an empty name.
+     */
+    struct dirnode_t
+    {
+        uint32_t parent_;
+        uint32_t first_child_;
+        uint32_t next_sibling_;
+        uint32_t first_entry_;
+        uint32_t entry_count_;
+        uint32_t name_offset_;
+        uint32_t name_length_;
+    };
+
+    /**
+     * Phases of opening a package. (Reported in order; count marks a finished open.)
+     */
+    enum class openphase : uint32_t
+    {
+        read_pki = 0,
+        validate_guid,
+        inflate_index,
+        parse_strings,
+        build_entries,
+        build_lookup,
+        count,
+    };
+
+    /**
+     * Structure definition for the progress of opening a package.
+     */
+    struct openprogress_t
+    {
+        dravex::openphase phase_;
+        uint64_t done_;
+        uint64_t total_;
+    };
+
+    /**
+     * Access patterns hinted to the system when reading the game.pkg file. (Applies to the next opened package.)
+     */
+    enum class accesspattern : uint32_t
+    {
+        normal = 0, // Default caching..
+        sequential, // A single pass over the package; reads ahead and drops the pages behind the reads..
+        random,     // Repeated random access; the mapping is populated when the package is opened..
+    };
+
+    /**
+     * Structure definition for the stored data of an uncompressed entry, viewed within the mapped game.pkg file.
+     */
+    struct entryview_t
+    {
+        const uint8_t* data_; // The entry data within the mapped file..
+        uint32_t size_;
+        HANDLE file_;         // The game.pkg file handle. (Source of block clones.)
+        uint64_t offset_;     // The entry data offset within the game.pkg file..
+        uint64_t file_size_;
+    };
+
+    /**
+     * Structure definition for an access point into the compressed data of an entry.
+     *
+     * Holds what is needed to resume inflating at a deflate block boundary without inflating the data before
+     * it; the position within the compressed data, down to the bit, and the 32KB of output preceding it.
+     */
+    struct accesspoint_t
+    {
+        uint64_t output_; // Offset within the uncompressed data..
+        uint32_t input_;  // Offset within the compressed data of the first whole byte after the access point..
+        uint32_t bits_;   // Number of bits of the previous byte that follow the access point..
+        std::vector<uint8_t> window_;
+    };
+
+    /**
+     * Structure definition for the access points of an entry, ordered by their uncompressed offset.
+     */
+    struct accessindex_t
+    {
+        std::vector<dravex::accesspoint_t> points_;
+        std::size_t size_; // Memory used by the access points..
+    };
+
+    /**
+     * Shared handle to the access points of an entry.
+     */
+    using accessindexptr_t = std::shared_ptr<const dravex::accessindex_t>;
+
+    /**
+     * Callback invoked with the progress of opening a package. (Invoked on the thread opening the package.)
+     */
+    using openprogressfn_t = std::function<void(const dravex::openprogress_t&)>;
+
+    /**
+     * Game asset package.
+     *
+     * Each package owns its own file handles, index and entry cache; any number of packages can be open at the
+     * same time and used in parallel from different threads. Packages are not movable themselves (background
+     * opens and reads refer to them), instead they are shared through packageptr_t handles which can be
+     * freely moved and copied, keeping the package alive for as long as any handle or background work holds it.
+     */
     class package final
     {
         package(package const&)            = delete;
@@ -62,34 +175,144 @@ namespace dravex
         package& operator=(package const&) = delete;
         package& operator=(package&&)      = delete;
 
-        package(void);
-        ~package(void);
-
         std::filesystem::path pki_path_;
         std::filesystem::path pkg_path_;
         FILE* pkg_file_;
+        std::mutex pkg_mutex_;
+
+        // Read-only mapping of the game.pkg file. (Serves uncompressed entries without copying them.)
+        HANDLE pkg_handle_;
+        HANDLE pkg_mapping_;
+        const uint8_t* pkg_view_;
+        uint64_t pkg_size_;
+
+        std::array<uint8_t, 16> guid_;
+        uint32_t version_;
+
+        // Parsed index. (All tables live within the index arena.)
+        dravex::arena arena_;
+        dravex::fileentry_t* entries_;
+        uint32_t entry_count_;
+        const char* names_;
+        uint32_t names_size_;
+        uint32_t* entry_table_;
+        uint32_t entry_table_mask_;
+        uint32_t* entry_dirs_;
+        uint32_t* entry_next_;
+        dravex::dirnode_t* dirs_;
+        uint32_t dir_count_;
+        uint32_t* dir_table_;
+        uint32_t dir_table_mask_;
+        const char* dir_names_;
+
+        dravex::accesspattern access_;
+
+        // Front-coded names. (Replaces the verbatim names once the index is built when enabled.)
+        bool compact_names_;
+        dravex::arena names_arena_;
+        dravex::namestore name_store_;
+
+        dravex::entrycache cache_;
+
+        // Access points of the large compressed entries, built on their first full read. (Most recent first.)
+        uint32_t access_span_;
+        uint64_t access_budget_;
+        uint64_t access_bytes_;
+        std::mutex access_mutex_;
+        std::list<std::tuple<uint32_t, dravex::accessindexptr_t>> access_lru_;
+        std::unordered_map<uint32_t, std::list<std::tuple<uint32_t, dravex::accessindexptr_t>>::iterator> access_indexes_;
 
-        std::vector<uint8_t> guid_;
-        std::vector<std::shared_ptr<fileentry_t>> entries_;
-        std::map<uint32_t, std::string> strings_;
+        // Open state. (Entries become visible through entries_ready_ while the index is being built.)
+        std::thread open_thread_;
+        std::atomic<bool> open_cancel_;
+        std::atomic<bool> opening_;
+        std::atomic<bool> open_result_;
+        std::atomic<uint32_t> open_phase_;
+        std::atomic<uint64_t> open_done_;
+        std::atomic<uint64_t> open_total_;
+        dravex::openprogressfn_t open_progress_;
+        std::atomic<uint32_t> entries_ready_;
+        std::atomic<bool> index_ready_;
+
+        auto load(const std::string& path) -> bool;
+        auto release(void) -> void;
+        auto map_data(void) -> void;
+        auto report(const dravex::openphase phase, const uint64_t done, const uint64_t total) -> bool;
 
         auto parse_v118(std::shared_ptr<dravex::binarybuffer> buffer) -> bool;
         auto parse_v666(std::shared_ptr<dravex::binarybuffer> buffer) -> bool;
 
+        auto prepare_index(const uint32_t entry_count, const char* string_table, const uint32_t string_table_size) -> void;
+        auto build_names(const char* string_table, const uint32_t string_table_size) -> bool;
+        auto build_lookup(void) -> bool;
+        auto build_name_store(void) -> void;
+        auto publish_entries(const uint32_t count) -> void;
+        auto get_name_view(const uint32_t index, std::string& scratch) -> std::string_view;
+
+        template<typename T>
+        auto read_entry_into(const int32_t index, T& output) -> bool;
+
     public:
-        static package& instance(void);
+        package(void);
+        ~package(void);
+
+        static std::shared_ptr<package> create(void);
         static const char* get_extension(const uint32_t file_type);
+        static const char* get_phase_name(const dravex::openphase phase);
+        static const char* get_access_pattern_name(const dravex::accesspattern pattern);
 
     public:
-        auto open(const std::string& path) -> bool;
+        auto open(const std::string& path, const dravex::openprogressfn_t& progress = nullptr) -> bool;
+        auto open_async(const std::string& path, const dravex::openprogressfn_t& progress = nullptr) -> void;
+        auto cancel_open(void) -> void;
+        auto wait_open(void) -> bool;
         auto close(void) -> void;
 
+        auto is_opening(void) const -> bool;
+        auto get_open_progress(void) const -> dravex::openprogress_t;
+
         auto get_entry_count(void) -> std::size_t;
-        auto get_entry(const int32_t index) -> std::shared_ptr<dravex::fileentry_t>;
+        auto get_entry(const int32_t index) -> const dravex::fileentry_t*;
+        auto find_entry(const std::string_view path) -> int32_t;
         auto get_entry_data(const int32_t index) -> std::vector<uint8_t>;
+        auto read_entry(const int32_t index, std::vector<uint8_t>& output) -> bool;
+        auto read_entry(const int32_t index, dravex::bytebuffer_t& output) -> bool;
+        auto read_entry_raw(const int32_t index, const uint32_t offset, uint8_t* output, const uint32_t size) -> uint32_t;
+        auto get_entry_buffer(const int32_t index) -> dravex::entrybuffer_t;
+        auto get_entry_view(const int32_t index, dravex::entryview_t& view) -> bool;
+        auto release_entry_view(const dravex::entryview_t& view) -> void;
+        auto get_access_index(const int32_t index) -> dravex::accessindexptr_t;
+        auto set_access_index(const int32_t index, const dravex::accessindexptr_t& access) -> void;
         auto get_string(const uint32_t offset) -> const char*;
+        auto get_entry_name(const int32_t index, std::string& output) -> bool;
+        auto for_each_sorted_entry(const std::function<bool(uint32_t, std::string_view)>& func) -> void;
+
+        auto get_directory_count(void) -> std::size_t;
+        auto get_directory(const uint32_t index) -> const dravex::dirnode_t*;
+        auto get_directory_path(const uint32_t index) -> std::string_view;
+        auto get_entry_directory(const int32_t index) -> uint32_t;
+        auto get_next_directory_entry(const int32_t index) -> uint32_t;
+
+        auto get_version(void) const -> uint32_t;
+        auto get_index_size(void) -> std::size_t;
+        auto get_compact_names(void) const -> bool;
+        auto set_compact_names(const bool enabled) -> void;
+        auto get_access_pattern(void) const -> dravex::accesspattern;
+        auto set_access_pattern(const dravex::accesspattern pattern) -> void;
+        auto get_access_span(void) const -> uint32_t;
+        auto set_access_span(const uint32_t span) -> void;
+        auto get_access_budget(void) const -> uint64_t;
+        auto set_access_budget(const uint64_t budget) -> void;
+        auto get_name_store(void) const -> const dravex::namestore&;
+
+        auto get_cache(void) -> dravex::entrycache&;
     };
 
+    /**
+     * Shared handle to a package.
+     */
+    using packageptr_t = std::shared_ptr<dravex::package>;
+
 } // namespace dravex
 
 #endif // PACKAGE_HPP
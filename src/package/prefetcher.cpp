@@ -0,0 +1,223 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "prefetcher.hpp"
+#include "package.hpp"
+#include "../stats.hpp"
+#include "../trace.hpp"
+
+/**
+ * Constructor and Destructor
+ */
+dravex::prefetcher::prefetcher(void)
+    : pool_{"prefetch", 1, THREAD_PRIORITY_LOWEST}
+    , generation_{0}
+    , enabled_{true}
+    , depth_{4}
+    , budget_{16 * 1024 * 1024}
+    , last_selected_{-1}
+    , last_start_{-1}
+    , direction_{1}
+{}
+dravex::prefetcher::~prefetcher(void)
+{
+    this->cancel();
+}
+
+/**
+ * Returns the singleton instance of this class.
+ *
+ * @return {prefetcher&} The singleton instance of this class.
+ */
+dravex::prefetcher& dravex::prefetcher::instance(void)
+{
+    static prefetcher p;
+    return p;
+}
+
+/**
+ * Queues the prefetch of the entries following the given anchor entry in the current direction.
+ *
+ * @param {dravex::packageptr_t&} pkg - The package to prefetch from.
+ * @param {int32_t} anchor - The entry to prefetch ahead of.
+ */
+void dravex::prefetcher::schedule(const dravex::packageptr_t& pkg, const int32_t anchor)
+{
+    const auto generation = ++this->generation_;
+    this->pool_.clear();
+
+    uint64_t bytes = 0;
+    for (uint32_t x = 1; x <= this->depth_; x++)
+    {
+        const auto index = anchor + this->direction_ * static_cast<int32_t>(x);
+        const auto entry = pkg->get_entry(index);
+        if (entry == nullptr)
+            break;
+
+        if (pkg->get_cache().contains(index))
+            continue;
+        if (bytes + entry->size_uncompressed_ > this->budget_)
+            break;
+
+        bytes += entry->size_uncompressed_;
+
+        this->pool_.submit([this, generation, pkg, index]() {
+            // Skip prefetches replaced by a newer update..
+            if (this->generation_.load() != generation)
+                return;
+
+            dravex::tracespan span{"prefetch", "asset", index};
+
+            const auto buffer = pkg->get_entry_buffer(index);
+            if (buffer == nullptr)
+                return;
+
+            dravex::stats::instance().add(dravex::counter::prefetch_entries, 1);
+            dravex::stats::instance().add(dravex::counter::prefetch_bytes, buffer->size());
+        });
+    }
+}
+
+/**
+ * Updates the prefetcher with the current asset list state. (Called once per frame.)
+ *
+ * @param {dravex::packageptr_t&} pkg - The package being viewed.
+ * @param {int32_t} selected - The selected entry index, -1 if none.
+ * @param {int32_t} visible_start - The first visible entry index of the list.
+ * @param {int32_t} visible_end - The entry index following the last visible entry of the list.
+ */
+void dravex::prefetcher::update(const dravex::packageptr_t& pkg, const int32_t selected, const int32_t visible_start, const int32_t visible_end)
+{
+    if (!this->enabled_ || pkg == nullptr)
+        return;
+
+    auto anchor = -1;
+
+    // Follow the selection, taking the direction from the previous selection..
+    if (selected >= 0 && selected != this->last_selected_)
+    {
+        if (this->last_selected_ >= 0)
+            this->direction_ = selected > this->last_selected_ ? 1 : -1;
+        anchor = selected;
+    }
+
+    // Otherwise follow the list scrolling, prefetching past the visible edge..
+    else if (this->last_start_ >= 0 && visible_start != this->last_start_ && visible_end > visible_start)
+    {
+        this->direction_ = visible_start > this->last_start_ ? 1 : -1;
+        anchor           = this->direction_ > 0 ? visible_end - 1 : visible_start;
+    }
+
+    this->last_selected_ = selected;
+    this->last_start_    = visible_start;
+
+    if (anchor >= 0)
+        this->schedule(pkg, anchor);
+}
+
+/**
+ * Drops all queued prefetches and resets the tracked list state.
+ */
+void dravex::prefetcher::cancel(void)
+{
+    this->generation_++;
+    this->pool_.clear();
+
+    this->last_selected_ = -1;
+    this->last_start_    = -1;
+    this->direction_     = 1;
+}
+
+/**
+ * Blocks until any prefetch in progress has finished. (Used before closing the package.)
+ */
+void dravex::prefetcher::wait(void)
+{
+    this->pool_.wait();
+}
+
+/**
+ * Returns if prefetching is enabled.
+ *
+ * @return {bool} True if enabled, false otherwise.
+ */
+bool dravex::prefetcher::get_enabled(void) const
+{
+    return this->enabled_;
+}
+
+/**
+ * Sets if prefetching is enabled.
+ *
+ * @param {bool} enabled - The enabled state.
+ */
+void dravex::prefetcher::set_enabled(const bool enabled)
+{
+    this->enabled_ = enabled;
+
+    if (!enabled)
+        this->cancel();
+}
+
+/**
+ * Returns the maximum number of entries prefetched ahead.
+ *
+ * @return {uint32_t} The prefetch depth.
+ */
+uint32_t dravex::prefetcher::get_depth(void) const
+{
+    return this->depth_;
+}
+
+/**
+ * Sets the maximum number of entries prefetched ahead.
+ *
+ * @param {uint32_t} depth - The prefetch depth.
+ */
+void dravex::prefetcher::set_depth(const uint32_t depth)
+{
+    this->depth_ = depth;
+}
+
+/**
+ * Returns the maximum number of decompressed bytes prefetched per update.
+ *
+ * @return {uint64_t} The byte budget.
+ */
+uint64_t dravex::prefetcher::get_budget(void) const
+{
+    return this->budget_;
+}
+
+/**
+ * Sets the maximum number of decompressed bytes prefetched per update.
+ *
+ * @param {uint64_t} budget - The byte budget.
+ */
+void dravex::prefetcher::set_budget(const uint64_t budget)
+{
+    this->budget_ = budget;
+}
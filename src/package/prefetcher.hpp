@@ -0,0 +1,88 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKAGE_PREFETCHER_HPP
+#define PACKAGE_PREFETCHER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "../defines.hpp"
+#include "../workpool.hpp"
+#include "package.hpp"
+
+namespace dravex
+{
+    /**
+     * Predictive entry prefetcher.
+     *
+     * Follows the selected entry and visible range of the asset list and warms the entry cache with the
+     * entries that follow in the direction the user is moving through the list. Reads are done on a low
+     * priority worker and are bounded by an entry count and a byte budget per update; a new update drops
+     * any prefetches of the previous update that have not started yet.
+     */
+    class prefetcher final
+    {
+        prefetcher(prefetcher const&)            = delete;
+        prefetcher(prefetcher&&)                 = delete;
+        prefetcher& operator=(prefetcher const&) = delete;
+        prefetcher& operator=(prefetcher&&)      = delete;
+
+        prefetcher(void);
+        ~prefetcher(void);
+
+        dravex::workpool pool_;
+        std::atomic<uint32_t> generation_;
+        std::atomic<bool> enabled_;
+        uint32_t depth_;
+        uint64_t budget_;
+
+        int32_t last_selected_;
+        int32_t last_start_;
+        int32_t direction_;
+
+        auto schedule(const dravex::packageptr_t& pkg, const int32_t anchor) -> void;
+
+    public:
+        static prefetcher& instance(void);
+
+    public:
+        auto update(const dravex::packageptr_t& pkg, const int32_t selected, const int32_t visible_start, const int32_t visible_end) -> void;
+        auto cancel(void) -> void;
+        auto wait(void) -> void;
+
+        auto get_enabled(void) const -> bool;
+        auto set_enabled(const bool enabled) -> void;
+        auto get_depth(void) const -> uint32_t;
+        auto set_depth(const uint32_t depth) -> void;
+        auto get_budget(void) const -> uint64_t;
+        auto set_budget(const uint64_t budget) -> void;
+    };
+
+} // namespace dravex
+
+#endif // PACKAGE_PREFETCHER_HPP
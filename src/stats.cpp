@@ -0,0 +1,310 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "stats.hpp"
+#include "imgui.h"
+
+namespace
+{
+    /**
+     * Holds the calling threads instrumentation block, returning it to the free list when the thread exits.
+     */
+    struct localblock_t
+    {
+        dravex::threadstats_t* block_ = nullptr;
+
+        ~localblock_t(void)
+        {
+            if (this->block_ != nullptr)
+                dravex::stats::instance().release(this->block_);
+        }
+    };
+
+    thread_local localblock_t local_block;
+
+} // namespace
+
+/**
+ * Constructor and Destructor
+ */
+dravex::stats::stats(void)
+    : enabled_{false}
+    , baseline_{}
+{}
+dravex::stats::~stats(void)
+{}
+
+/**
+ * Returns the singleton instance of this class.
+ *
+ * @return {stats&} The singleton instance of this class.
+ */
+dravex::stats& dravex::stats::instance(void)
+{
+    static dravex::stats s;
+    return s;
+}
+
+/**
+ * Returns the instrumentation block of the calling thread, acquiring one if needed.
+ *
+ * @return {dravex::threadstats_t*} The calling threads instrumentation block.
+ */
+dravex::threadstats_t* dravex::stats::get_local(void)
+{
+    if (local_block.block_ == nullptr)
+        local_block.block_ = this->acquire();
+
+    return local_block.block_;
+}
+
+/**
+ * Acquires an instrumentation block for a new thread, reusing blocks of exited threads when possible.
+ *
+ * @return {dravex::threadstats_t*} The instrumentation block.
+ */
+dravex::threadstats_t* dravex::stats::acquire(void)
+{
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    if (!this->free_blocks_.empty())
+    {
+        const auto block = this->free_blocks_.back();
+        this->free_blocks_.pop_back();
+        return block;
+    }
+
+    this->blocks_.push_back(std::make_unique<dravex::threadstats_t>());
+    return this->blocks_.back().get();
+}
+
+/**
+ * Releases an instrumentation block of an exiting thread. (The blocks values are kept in the totals.)
+ *
+ * @param {dravex::threadstats_t*} block - The instrumentation block.
+ */
+void dravex::stats::release(dravex::threadstats_t* block)
+{
+    std::lock_guard<std::mutex> lock{this->mutex_};
+    this->free_blocks_.push_back(block);
+}
+
+/**
+ * Sums the instrumentation blocks of all threads.
+ *
+ * @return {dravex::statsnapshot_t} The summed values.
+ */
+dravex::statsnapshot_t dravex::stats::collect(void) const
+{
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    dravex::statsnapshot_t snap{};
+    for (const auto& b : this->blocks_)
+    {
+        for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::counter::count); x++)
+            snap.counters_[x] += b->counters_[x].load(std::memory_order_relaxed);
+
+        for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::stage::count); x++)
+        {
+            snap.stage_ns_[x] += b->stage_ns_[x].load(std::memory_order_relaxed);
+            snap.stage_calls_[x] += b->stage_calls_[x].load(std::memory_order_relaxed);
+        }
+    }
+
+    return snap;
+}
+
+/**
+ * Returns the aggregated instrumentation values since the last reset.
+ *
+ * @return {dravex::statsnapshot_t} The aggregated values.
+ */
+dravex::statsnapshot_t dravex::stats::snapshot(void) const
+{
+    auto snap = this->collect();
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::counter::count); x++)
+        snap.counters_[x] -= std::min(snap.counters_[x], this->baseline_.counters_[x]);
+
+    for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::stage::count); x++)
+    {
+        snap.stage_ns_[x] -= std::min(snap.stage_ns_[x], this->baseline_.stage_ns_[x]);
+        snap.stage_calls_[x] -= std::min(snap.stage_calls_[x], this->baseline_.stage_calls_[x]);
+    }
+
+    return snap;
+}
+
+/**
+ * Resets the aggregated instrumentation values.
+ *
+ * The per-thread blocks are never written by other threads, so a reset records a baseline instead of zeroing them.
+ */
+void dravex::stats::reset(void)
+{
+    const auto snap = this->collect();
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+    this->baseline_ = snap;
+}
+
+/**
+ * Returns the display name of the given counter.
+ *
+ * @param {dravex::counter} c - The counter.
+ * @return {const char*} The counter name.
+ */
+const char* dravex::stats::get_counter_name(const dravex::counter c)
+{
+    switch (c)
+    {
+        case dravex::counter::bytes_read:
+            return "bytes_read";
+        case dravex::counter::bytes_inflated:
+            return "bytes_inflated";
+        case dravex::counter::bytes_written:
+            return "bytes_written";
+        case dravex::counter::entries_served:
+            return "entries_served";
+        case dravex::counter::cache_hits:
+            return "cache_hits";
+        case dravex::counter::cache_misses:
+            return "cache_misses";
+        case dravex::counter::cache_evictions:
+            return "cache_evictions";
+        case dravex::counter::pool_hits:
+            return "pool_hits";
+        case dravex::counter::pool_misses:
+            return "pool_misses";
+        case dravex::counter::index_bytes:
+            return "index_bytes";
+        case dravex::counter::names_bytes:
+            return "names_bytes";
+        case dravex::counter::names_raw_bytes:
+            return "names_raw_bytes";
+        case dravex::counter::prefetch_entries:
+            return "prefetch_entries";
+        case dravex::counter::prefetch_bytes:
+            return "prefetch_bytes";
+        case dravex::counter::write_calls:
+            return "write_calls";
+        case dravex::counter::zerocopy_bytes:
+            return "zerocopy_bytes";
+        case dravex::counter::cloned_bytes:
+            return "cloned_bytes";
+        case dravex::counter::access_points:
+            return "access_points";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Returns the display name of the given stage.
+ *
+ * @param {dravex::stage} s - The stage.
+ * @return {const char*} The stage name.
+ */
+const char* dravex::stats::get_stage_name(const dravex::stage s)
+{
+    switch (s)
+    {
+        case dravex::stage::read:
+            return "read";
+        case dravex::stage::inflate:
+            return "inflate";
+        case dravex::stage::mkdir:
+            return "mkdir";
+        case dravex::stage::write:
+            return "write";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Renders the instrumentation panel via ImGui.
+ */
+void dravex::stats::render(void)
+{
+    auto enabled = this->is_enabled();
+    if (ImGui::Checkbox("Enable Instrumentation", &enabled))
+        this->set_enabled(enabled);
+    ImGui::SameLine();
+    if (ImGui::Button("Reset"))
+        this->reset();
+
+    const auto snap = this->snapshot();
+
+    if (ImGui::BeginTable("##dravex_stats_counters", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoSavedSettings))
+    {
+        ImGui::TableSetupColumn("Counter", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::counter::count); x++)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text(get_counter_name(static_cast<dravex::counter>(x)));
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text(std::format("{}", snap.counters_[x]).c_str());
+        }
+
+        ImGui::EndTable();
+    }
+
+    if (ImGui::BeginTable("##dravex_stats_stages", 4, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoSavedSettings))
+    {
+        ImGui::TableSetupColumn("Stage", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Total (ms)", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Average (us)", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        for (uint32_t x = 0; x < static_cast<uint32_t>(dravex::stage::count); x++)
+        {
+            const auto calls = snap.stage_calls_[x];
+            const auto ms    = static_cast<double>(snap.stage_ns_[x]) / 1e6;
+            const auto avg   = calls > 0 ? static_cast<double>(snap.stage_ns_[x]) / 1e3 / static_cast<double>(calls) : 0.0;
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text(get_stage_name(static_cast<dravex::stage>(x)));
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text(std::format("{}", calls).c_str());
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text(std::format("{:.3f}", ms).c_str());
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text(std::format("{:.3f}", avg).c_str());
+        }
+
+        ImGui::EndTable();
+    }
+}
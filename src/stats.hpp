@@ -0,0 +1,224 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Instrumentation counters.
+     */
+    enum class counter : uint32_t
+    {
+        bytes_read = 0,
+        bytes_inflated,
+        bytes_written,
+        entries_served,
+        cache_hits,
+        cache_misses,
+        cache_evictions,
+        pool_hits,
+        pool_misses,
+        index_bytes,
+        names_bytes,
+        names_raw_bytes,
+        prefetch_entries,
+        prefetch_bytes,
+        write_calls,
+        zerocopy_bytes,
+        cloned_bytes,
+        access_points,
+        count,
+    };
+
+    /**
+     * Instrumentation timed stages.
+     */
+    enum class stage : uint32_t
+    {
+        read = 0,
+        inflate,
+        mkdir,
+        write,
+        count,
+    };
+
+    /**
+     * Structure definition for an aggregated snapshot of the instrumentation data.
+     */
+    struct statsnapshot_t
+    {
+        uint64_t counters_[static_cast<uint32_t>(dravex::counter::count)];
+        uint64_t stage_ns_[static_cast<uint32_t>(dravex::stage::count)];
+        uint64_t stage_calls_[static_cast<uint32_t>(dravex::stage::count)];
+    };
+
+    /**
+     * Structure definition for the per-thread instrumentation data.
+     *
+     * Each block is only ever written by the thread that owns it, readers aggregate the blocks on demand.
+     */
+    struct threadstats_t
+    {
+        std::atomic<uint64_t> counters_[static_cast<uint32_t>(dravex::counter::count)];
+        std::atomic<uint64_t> stage_ns_[static_cast<uint32_t>(dravex::stage::count)];
+        std::atomic<uint64_t> stage_calls_[static_cast<uint32_t>(dravex::stage::count)];
+
+        threadstats_t(void)
+            : counters_{}
+            , stage_ns_{}
+            , stage_calls_{}
+        {}
+    };
+
+    class stats final
+    {
+        stats(stats const&)            = delete;
+        stats(stats&&)                 = delete;
+        stats& operator=(stats const&) = delete;
+        stats& operator=(stats&&)      = delete;
+
+        stats(void);
+        ~stats(void);
+
+        std::atomic<bool> enabled_;
+
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<dravex::threadstats_t>> blocks_;
+        std::vector<dravex::threadstats_t*> free_blocks_;
+        statsnapshot_t baseline_;
+
+        auto get_local(void) -> dravex::threadstats_t*;
+        auto collect(void) const -> dravex::statsnapshot_t;
+
+    public:
+        static stats& instance(void);
+
+        auto acquire(void) -> dravex::threadstats_t*;
+        auto release(dravex::threadstats_t* block) -> void;
+
+        auto snapshot(void) const -> dravex::statsnapshot_t;
+        auto reset(void) -> void;
+        auto render(void) -> void;
+
+        static auto get_counter_name(const dravex::counter c) -> const char*;
+        static auto get_stage_name(const dravex::stage s) -> const char*;
+
+        /**
+         * Returns if instrumentation is currently enabled.
+         *
+         * @return {bool} True if enabled, false otherwise.
+         */
+        auto is_enabled(void) const noexcept -> bool
+        {
+            return this->enabled_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Sets if instrumentation is enabled.
+         *
+         * @param {bool} enabled - The new enabled state.
+         */
+        auto set_enabled(const bool enabled) noexcept -> void
+        {
+            this->enabled_.store(enabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * Adds the given value to the calling threads counter.
+         *
+         * @param {dravex::counter} c - The counter to add to.
+         * @param {uint64_t} value - The value to add.
+         */
+        auto add(const dravex::counter c, const uint64_t value) -> void
+        {
+            if (!this->is_enabled())
+                return;
+
+            // Only the owning thread writes to its block, so a plain load/store pair avoids a locked add..
+            auto& v = this->get_local()->counters_[static_cast<uint32_t>(c)];
+            v.store(v.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        /**
+         * Adds the given elapsed time to the calling threads stage timer.
+         *
+         * @param {dravex::stage} s - The stage to add to.
+         * @param {uint64_t} ns - The elapsed time, in nanoseconds.
+         */
+        auto add_time(const dravex::stage s, const uint64_t ns) -> void
+        {
+            auto local = this->get_local();
+
+            auto& t = local->stage_ns_[static_cast<uint32_t>(s)];
+            auto& c = local->stage_calls_[static_cast<uint32_t>(s)];
+            t.store(t.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Scoped stage timer; records the time spent within its scope when instrumentation is enabled.
+     */
+    class scopedtimer final
+    {
+        dravex::stage stage_;
+        std::chrono::steady_clock::time_point start_;
+        bool enabled_;
+
+    public:
+        explicit scopedtimer(const dravex::stage s)
+            : stage_{s}
+            , start_{}
+            , enabled_{dravex::stats::instance().is_enabled()}
+        {
+            if (this->enabled_)
+                this->start_ = std::chrono::steady_clock::now();
+        }
+        ~scopedtimer(void)
+        {
+            if (this->enabled_)
+            {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start_).count();
+                dravex::stats::instance().add_time(this->stage_, static_cast<uint64_t>(ns));
+            }
+        }
+
+        scopedtimer(scopedtimer const&)            = delete;
+        scopedtimer& operator=(scopedtimer const&) = delete;
+    };
+
+} // namespace dravex
+
+#endif // STATS_HPP
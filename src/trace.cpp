@@ -0,0 +1,240 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "trace.hpp"
+#include "utils.hpp"
+
+namespace
+{
+    /**
+     * Holds the calling threads trace buffer, marking it retired when the thread exits.
+     */
+    struct localbuffer_t
+    {
+        dravex::tracebuffer_t* buffer_ = nullptr;
+
+        ~localbuffer_t(void)
+        {
+            if (this->buffer_ != nullptr)
+                dravex::tracing::instance().retire(this->buffer_);
+        }
+    };
+
+    thread_local localbuffer_t local_buffer;
+
+} // namespace
+
+/**
+ * Constructor and Destructor
+ */
+dravex::tracing::tracing(void)
+    : enabled_{false}
+    , epoch_{std::chrono::steady_clock::now()}
+{}
+dravex::tracing::~tracing(void)
+{}
+
+/**
+ * Returns the singleton instance of this class.
+ *
+ * @return {tracing&} The singleton instance of this class.
+ */
+dravex::tracing& dravex::tracing::instance(void)
+{
+    static dravex::tracing t;
+    return t;
+}
+
+/**
+ * Returns the trace buffer of the calling thread, registering one if needed.
+ *
+ * @return {dravex::tracebuffer_t*} The calling threads trace buffer.
+ */
+dravex::tracebuffer_t* dravex::tracing::get_local(void)
+{
+    if (local_buffer.buffer_ != nullptr)
+        return local_buffer.buffer_;
+
+    auto buffer        = std::make_unique<dravex::tracebuffer_t>();
+    buffer->thread_id_ = ::GetCurrentThreadId();
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+    this->buffers_.push_back(std::move(buffer));
+
+    local_buffer.buffer_ = this->buffers_.back().get();
+    return local_buffer.buffer_;
+}
+
+/**
+ * Marks the given trace buffer as retired. (Its thread has exited.)
+ *
+ * @param {dravex::tracebuffer_t*} buffer - The trace buffer.
+ */
+void dravex::tracing::retire(dravex::tracebuffer_t* buffer)
+{
+    buffer->retired_.store(true, std::memory_order_release);
+}
+
+/**
+ * Records a completed span into the calling threads trace buffer.
+ *
+ * @param {const char*} name - The span name.
+ * @param {const char*} category - The span category.
+ * @param {uint64_t} start_ns - The span start timestamp.
+ * @param {uint64_t} duration_ns - The span duration.
+ * @param {int64_t} arg - The span argument. (-1 if not used.)
+ */
+void dravex::tracing::record(const char* name, const char* category, const uint64_t start_ns, const uint64_t duration_ns, const int64_t arg)
+{
+    auto buffer = this->get_local();
+
+    // Restart the buffer once it has been cleared..
+    const auto generation = buffer->generation_.load(std::memory_order_acquire);
+    if (generation != buffer->seen_)
+    {
+        std::lock_guard<std::mutex> lock{this->mutex_};
+
+        buffer->seen_  = generation;
+        buffer->start_ = 0;
+        buffer->count_.store(0, std::memory_order_release);
+        buffer->dropped_.store(0, std::memory_order_relaxed);
+    }
+
+    const auto index = buffer->count_.load(std::memory_order_relaxed);
+    const auto chunk = index / dravex::tracebuffer_t::chunk_size;
+
+    // Drop the event if the buffer is full..
+    if (chunk >= dravex::tracebuffer_t::max_chunks)
+    {
+        buffer->dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Allocate the next chunk if needed..
+    auto events = buffer->chunks_[chunk].load(std::memory_order_relaxed);
+    if (events == nullptr)
+    {
+        events = new dravex::traceevent_t[dravex::tracebuffer_t::chunk_size];
+        buffer->chunks_[chunk].store(events, std::memory_order_release);
+    }
+
+    events[index % dravex::tracebuffer_t::chunk_size] = {name, category, start_ns, duration_ns, arg};
+
+    // Publish the event..
+    buffer->count_.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * Sets the name of the calling thread shown in the trace viewer.
+ *
+ * @param {const char*} name - The thread name.
+ */
+void dravex::tracing::set_thread_name(const char* name)
+{
+    auto buffer = this->get_local();
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+    buffer->thread_name_ = name;
+}
+
+/**
+ * Clears the recorded trace events, releasing the buffers of exited threads.
+ */
+void dravex::tracing::clear(void)
+{
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    std::erase_if(this->buffers_, [](const std::unique_ptr<dravex::tracebuffer_t>& b) {
+        return b->retired_.load(std::memory_order_acquire);
+    });
+
+    // Buffers of live threads are owned by their writers; skip past their current events until the
+    // writers restart them on their next event..
+    for (auto& b : this->buffers_)
+    {
+        b->start_ = b->count_.load(std::memory_order_acquire);
+        b->dropped_.store(0, std::memory_order_relaxed);
+        b->generation_.fetch_add(1, std::memory_order_release);
+    }
+}
+
+/**
+ * Writes the recorded trace events to the given file in the Chrome trace event format.
+ *
+ * @param {std::string&} path - The path to the file to write.
+ * @return {bool} True on success, false otherwise.
+ */
+bool dravex::tracing::write(const std::string& path) const
+{
+    FILE* f = nullptr;
+    if (::fopen_s(&f, path.c_str(), "wb") != ERROR_SUCCESS)
+        return false;
+
+    std::lock_guard<std::mutex> lock{this->mutex_};
+
+    const auto pid = ::GetCurrentProcessId();
+    auto first     = true;
+
+    const auto emit = [&](const std::string& line) {
+        ::fputs(first ? "\n" : ",\n", f);
+        ::fputs(line.c_str(), f);
+        first = false;
+    };
+
+    ::fputs("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [", f);
+
+    for (const auto& b : this->buffers_)
+    {
+        const auto count = b->count_.load(std::memory_order_acquire);
+
+        // Emit the thread name metadata..
+        if (!b->thread_name_.empty())
+            emit(std::format(R"({{"name": "thread_name", "ph": "M", "pid": {}, "tid": {}, "args": {{"name": "{}"}}}})", pid, b->thread_id_, dravex::utils::json_escape(b->thread_name_)));
+
+        const auto dropped = b->dropped_.load(std::memory_order_relaxed);
+        if (dropped > 0)
+            emit(std::format(R"({{"name": "dropped_events", "ph": "i", "s": "t", "ts": 0, "pid": {}, "tid": {}, "args": {{"count": {}}}}})", pid, b->thread_id_, dropped));
+
+        for (auto x = b->start_; x < count; x++)
+        {
+            const auto& e = b->chunks_[x / dravex::tracebuffer_t::chunk_size].load(std::memory_order_acquire)[x % dravex::tracebuffer_t::chunk_size];
+
+            auto line = std::format(R"({{"name": "{}", "cat": "{}", "ph": "X", "ts": {:.3f}, "dur": {:.3f}, "pid": {}, "tid": {})",
+                dravex::utils::json_escape(e.name_ == nullptr ? "" : e.name_), dravex::utils::json_escape(e.category_ == nullptr ? "" : e.category_), static_cast<double>(e.start_ns_) / 1000.0, static_cast<double>(e.duration_ns_) / 1000.0, pid, b->thread_id_);
+            if (e.arg_ >= 0)
+                line += std::format(R"(, "args": {{"index": {}}})", e.arg_);
+            line += "}";
+
+            emit(line);
+        }
+    }
+
+    ::fputs("\n]}\n", f);
+    ::fclose(f);
+
+    return true;
+}
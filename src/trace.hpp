@@ -0,0 +1,189 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Structure definition for a single completed trace span.
+     */
+    struct traceevent_t
+    {
+        const char* name_;
+        const char* category_;
+        uint64_t start_ns_;
+        uint64_t duration_ns_;
+        int64_t arg_;
+    };
+
+    /**
+     * Structure definition for a per-thread trace buffer.
+     *
+     * Only the owning thread appends events; the event count is published with release semantics so
+     * readers can walk the buffer without locking. Events are stored in lazily allocated fixed chunks
+     * so that published events never move. Clearing bumps the generation; the owning thread then restarts
+     * the buffer at its first event, reusing the allocated chunks.
+     */
+    struct tracebuffer_t
+    {
+        static constexpr std::size_t chunk_size = 4096;
+        static constexpr std::size_t max_chunks = 64;
+
+        std::atomic<dravex::traceevent_t*> chunks_[max_chunks];
+        std::atomic<std::size_t> count_;
+        std::atomic<std::size_t> dropped_;
+        std::atomic<bool> retired_;
+        std::atomic<uint32_t> generation_;
+        uint32_t seen_; // Generation last seen by the owning thread..
+        std::size_t start_;
+        uint32_t thread_id_;
+        std::string thread_name_;
+
+        tracebuffer_t(void)
+            : chunks_{}
+            , count_{0}
+            , dropped_{0}
+            , retired_{false}
+            , generation_{0}
+            , seen_{0}
+            , start_{0}
+            , thread_id_{0}
+        {}
+        ~tracebuffer_t(void)
+        {
+            for (auto& c : this->chunks_)
+                delete[] c.load();
+        }
+    };
+
+    class tracing final
+    {
+        tracing(tracing const&)            = delete;
+        tracing(tracing&&)                 = delete;
+        tracing& operator=(tracing const&) = delete;
+        tracing& operator=(tracing&&)      = delete;
+
+        tracing(void);
+        ~tracing(void);
+
+        std::atomic<bool> enabled_;
+        std::chrono::steady_clock::time_point epoch_;
+
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<dravex::tracebuffer_t>> buffers_;
+
+        auto get_local(void) -> dravex::tracebuffer_t*;
+
+    public:
+        static tracing& instance(void);
+
+        auto retire(dravex::tracebuffer_t* buffer) -> void;
+        auto record(const char* name, const char* category, const uint64_t start_ns, const uint64_t duration_ns, const int64_t arg) -> void;
+        auto set_thread_name(const char* name) -> void;
+
+        auto clear(void) -> void;
+        auto write(const std::string& path) const -> bool;
+
+        /**
+         * Returns if tracing is currently enabled.
+         *
+         * @return {bool} True if enabled, false otherwise.
+         */
+        auto is_enabled(void) const noexcept -> bool
+        {
+            return this->enabled_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Sets if tracing is enabled.
+         *
+         * @param {bool} enabled - The new enabled state.
+         */
+        auto set_enabled(const bool enabled) noexcept -> void
+        {
+            this->enabled_.store(enabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * Returns the current trace timestamp, in nanoseconds since the trace epoch.
+         *
+         * @return {uint64_t} The current timestamp.
+         */
+        auto now(void) const noexcept -> uint64_t
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->epoch_).count());
+        }
+    };
+
+    /**
+     * Scoped trace span; records a complete event covering its scope when tracing is enabled.
+     *
+     * The name and category must be string literals (or otherwise outlive the trace) as only the pointers are stored.
+     */
+    class tracespan final
+    {
+        const char* name_;
+        const char* category_;
+        int64_t arg_;
+        uint64_t start_;
+        bool enabled_;
+
+    public:
+        tracespan(const char* name, const char* category, const int64_t arg = -1)
+            : name_{name}
+            , category_{category}
+            , arg_{arg}
+            , start_{0}
+            , enabled_{dravex::tracing::instance().is_enabled()}
+        {
+            if (this->enabled_)
+                this->start_ = dravex::tracing::instance().now();
+        }
+        ~tracespan(void)
+        {
+            if (this->enabled_)
+            {
+                auto& t = dravex::tracing::instance();
+                t.record(this->name_, this->category_, this->start_, t.now() - this->start_, this->arg_);
+            }
+        }
+
+        tracespan(tracespan const&)            = delete;
+        tracespan& operator=(tracespan const&) = delete;
+    };
+
+} // namespace dravex
+
+#endif // TRACE_HPP
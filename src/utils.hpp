@@ -36,52 +36,98 @@
 
 namespace dravex::utils
 {
+    /**
+     * Structure definition for a reusable zlib inflate stream.
+     */
+    struct inflatestream_t
+    {
+        z_stream stream_;
+        bool ready_;
+
+        inflatestream_t(void)
+            : stream_{}
+            , ready_{inflateInit(&stream_) == Z_OK}
+        {}
+        ~inflatestream_t(void)
+        {
+            if (this->ready_)
+                inflateEnd(&this->stream_);
+        }
+    };
+
+    /**
+     * Returns the calling threads inflate stream, reset and ready for a new input.
+     *
+     * Reusing the stream avoids the zlib state and window allocations of inflateInit on every call.
+     *
+     * @return {z_stream*} The inflate stream on success, nullptr otherwise.
+     */
+    static z_stream* get_inflate_stream(void)
+    {
+        thread_local inflatestream_t stream;
+        if (!stream.ready_ || inflateReset(&stream.stream_) != Z_OK)
+            return nullptr;
+        return &stream.stream_;
+    }
+
     /**
      * Inflates the given compressed input data using zlib.
      *
+     * The data is inflated directly into the output vector, after any existing contents. The vectors existing
+     * capacity is used first; reserve it up front (ie. with the known decompressed size) to avoid reallocations.
+     * The output is grown to its capacity before inflating; use a dravex::bytebuffer_t for large, pooled outputs
+     * so the growth does not zero the capacity first.
+     *
      * @param {uint8_t*} input - The input data to inflate.
      * @param {std::size_t} input_size - The input data length.
      * @param {std::size_t} offset - The input data offset to start the inflating at.
      * @param {std::vector&} output - The output vector to hold the inflated data.
      * @return {bool} True on success, false otherwise.
      */
-    static bool inflate(const uint8_t* input, const std::size_t input_size, const std::size_t offset, std::vector<uint8_t>& output)
+    template<typename T>
+    static bool inflate(const uint8_t* input, const std::size_t input_size, const std::size_t offset, T& output)
     {
-        // Initialize the zlib stream..
-        z_stream zstream{};
-        if (inflateInit(&zstream) != Z_OK)
+        // Obtain the zlib stream..
+        auto zstream = get_inflate_stream();
+        if (zstream == nullptr)
             return false;
 
         // Prepare the stream input..
-        zstream.avail_in = input_size - offset;
-        zstream.next_in  = const_cast<uint8_t*>(input + offset);
+        zstream->avail_in = static_cast<uInt>(input_size - offset);
+        zstream->next_in  = const_cast<uint8_t*>(input + offset);
 
-        std::vector<uint8_t> chunk(1024, '\0');
+        // Prepare the output space..
+        const auto start = output.size();
+        auto used        = start;
+        output.resize(std::max(output.capacity(), start + 1024));
 
-        do
+        while (true)
         {
-            // Prepare the output chunk..
-            zstream.avail_out = 1024;
-            zstream.next_out  = chunk.data();
+            zstream->avail_out = static_cast<uInt>(output.size() - used);
+            zstream->next_out  = output.data() + used;
 
             // Inflate the input data..
-            switch (inflate(&zstream, Z_NO_FLUSH))
+            const auto ret = ::inflate(zstream, Z_NO_FLUSH);
+            used           = output.size() - zstream->avail_out;
+
+            switch (ret)
             {
                 case Z_NEED_DICT:
                 case Z_DATA_ERROR:
                 case Z_MEM_ERROR:
-                    inflateEnd(&zstream);
+                    output.resize(start);
                     return false;
             }
 
-            // Copy the inflated data to the output vector..
-            const auto size = 1024 - zstream.avail_out;
-            output.insert(output.end(), chunk.begin(), chunk.begin() + size);
+            // Stop once the stream has ended or the input is exhausted..
+            if (ret == Z_STREAM_END || zstream->avail_out != 0)
+                break;
 
-        } while (zstream.avail_out == 0);
+            // Grow the output space..
+            output.resize(output.size() * 2);
+        }
 
-        // Cleanup the zlib stream..
-        inflateEnd(&zstream);
+        output.resize(used);
         return true;
     }
 
@@ -98,6 +144,188 @@ namespace dravex::utils
         return adler32_z(adler, input, input_size);
     }
 
+    /**
+     * Structure definition for a reusable SHA-256 algorithm provider.
+     */
+    struct sha256provider_t
+    {
+        BCRYPT_ALG_HANDLE handle_;
+        bool ready_;
+
+        sha256provider_t(void)
+            : handle_{nullptr}
+            , ready_{BCRYPT_SUCCESS(::BCryptOpenAlgorithmProvider(&handle_, BCRYPT_SHA256_ALGORITHM, nullptr, 0))}
+        {}
+        ~sha256provider_t(void)
+        {
+            if (this->ready_)
+                ::BCryptCloseAlgorithmProvider(this->handle_, 0);
+        }
+    };
+
+    /**
+     * Calculates the SHA-256 digest of the given input data.
+     *
+     * The algorithm provider is opened once per thread, as opening it is far more expensive than hashing an entry.
+     *
+     * @param {uint8_t*} input - The input buffer.
+     * @param {std::size_t} input_size - The input buffer size.
+     * @param {std::array&} output - The output array to hold the digest.
+     * @return {bool} True on success, false otherwise.
+     */
+    static bool sha256(const uint8_t* input, const std::size_t input_size, std::array<uint8_t, 32>& output)
+    {
+        thread_local sha256provider_t provider;
+        if (!provider.ready_)
+            return false;
+
+        BCRYPT_HASH_HANDLE hash = nullptr;
+        if (!BCRYPT_SUCCESS(::BCryptCreateHash(provider.handle_, &hash, nullptr, 0, nullptr, 0, 0)))
+            return false;
+
+        // Hash the input in chunks, as the size of a single call is limited to a ULONG..
+        auto ret = true;
+        for (std::size_t offset = 0; ret && offset < input_size;)
+        {
+            const auto size = static_cast<ULONG>(std::min<std::size_t>(input_size - offset, 0x40000000));
+            ret             = BCRYPT_SUCCESS(::BCryptHashData(hash, const_cast<PUCHAR>(input + offset), size, 0));
+            offset += size;
+        }
+
+        ret = ret && BCRYPT_SUCCESS(::BCryptFinishHash(hash, output.data(), static_cast<ULONG>(output.size()), 0));
+        ::BCryptDestroyHash(hash);
+        return ret;
+    }
+
+    /**
+     * Converts the given data to a lowercase hex string.
+     *
+     * @param {uint8_t*} input - The input buffer.
+     * @param {std::size_t} input_size - The input buffer size.
+     * @return {std::string} The hex string.
+     */
+    static std::string to_hex(const uint8_t* input, const std::size_t input_size)
+    {
+        static constexpr char digits[] = "0123456789abcdef";
+
+        std::string output(input_size * 2, '\0');
+        for (std::size_t x = 0; x < input_size; x++)
+        {
+            output[x * 2 + 0] = digits[input[x] >> 4];
+            output[x * 2 + 1] = digits[input[x] & 0x0F];
+        }
+        return output;
+    }
+
+    /**
+     * Returns the length of the valid UTF-8 sequence at the start of the given string.
+     *
+     * @param {std::string_view} str - The string to check.
+     * @return {std::size_t} The sequence length, 0 if the string does not start with a valid sequence.
+     */
+    static std::size_t get_utf8_length(const std::string_view str)
+    {
+        const auto byte = [&str](const std::size_t x) {
+            return x < str.size() ? static_cast<uint8_t>(str[x]) : 0;
+        };
+
+        const auto c = byte(0);
+        if (c < 0x80)
+            return str.empty() ? 0 : 1;
+
+        // Obtain the sequence length and the allowed range of the second byte; rejecting overlong forms, surrogates and values above U+10FFFF..
+        std::size_t length = 0;
+        uint8_t low        = 0x80;
+        uint8_t high       = 0xBF;
+
+        if (c >= 0xC2 && c <= 0xDF)
+            length = 2;
+        else if (c >= 0xE0 && c <= 0xEF)
+        {
+            length = 3;
+            low    = c == 0xE0 ? 0xA0 : 0x80;
+            high   = c == 0xED ? 0x9F : 0xBF;
+        }
+        else if (c >= 0xF0 && c <= 0xF4)
+        {
+            length = 4;
+            low    = c == 0xF0 ? 0x90 : 0x80;
+            high   = c == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+            return 0;
+
+        if (byte(1) < low || byte(1) > high)
+            return 0;
+
+        for (std::size_t x = 2; x < length; x++)
+        {
+            if (byte(x) < 0x80 || byte(x) > 0xBF)
+                return 0;
+        }
+
+        return length;
+    }
+
+    /**
+     * Escapes the given string for use within a JSON document.
+     *
+     * Control characters are written as escape sequences. Bytes that are not part of a valid UTF-8 sequence
+     * are written as the Latin-1 character of the same value, so the output is always valid UTF-8.
+     *
+     * @param {std::string_view} str - The string to escape.
+     * @return {std::string} The escaped string.
+     */
+    static std::string json_escape(const std::string_view str)
+    {
+        std::string out;
+        out.reserve(str.size());
+
+        for (std::size_t x = 0; x < str.size(); x++)
+        {
+            const auto c = static_cast<uint8_t>(str[x]);
+            switch (c)
+            {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\b':
+                    out += "\\b";
+                    break;
+                case '\f':
+                    out += "\\f";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                {
+                    // Copy valid UTF-8 sequences as-is..
+                    const auto length = c < 0x20 ? 0 : get_utf8_length(str.substr(x));
+                    if (length == 0)
+                        out += std::format("\\u{:04x}", c);
+                    else
+                    {
+                        out.append(str.substr(x, length));
+                        x += length - 1;
+                    }
+                    break;
+                }
+            }
+        }
+
+        return out;
+    }
+
     /**
      * Parses a block of null terminated strings into a map.
      *
@@ -120,6 +348,84 @@ namespace dravex::utils
         }
     }
 
+    /**
+     * Normalizes a path character for hashing and comparing. (Case and separator insensitive.)
+     *
+     * @param {char} c - The character to normalize.
+     * @return {uint8_t} The normalized character.
+     */
+    static uint8_t normalize_path(const char c)
+    {
+        if (c == '/')
+            return '\\';
+        if (c >= 'A' && c <= 'Z')
+            return static_cast<uint8_t>(c - 'A' + 'a');
+        return static_cast<uint8_t>(c);
+    }
+
+    /**
+     * Returns the FNV-1a hash of the given normalized path.
+     *
+     * @param {std::string_view} path - The path to hash.
+     * @return {uint32_t} The path hash.
+     */
+    static uint32_t hash_path(const std::string_view path)
+    {
+        auto hash = 2166136261u;
+        for (const auto c : path)
+            hash = (hash ^ normalize_path(c)) * 16777619u;
+        return hash;
+    }
+
+    /**
+     * Returns if the two given paths are equal once normalized.
+     *
+     * @param {std::string_view} a - The first path.
+     * @param {std::string_view} b - The second path.
+     * @return {bool} True if equal, false otherwise.
+     */
+    static bool equal_path(const std::string_view a, const std::string_view b)
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (std::size_t x = 0; x < a.size(); x++)
+        {
+            if (normalize_path(a[x]) != normalize_path(b[x]))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Returns the lookup table capacity for the given number of items. (Power of two, at most half full.)
+     *
+     * @param {std::size_t} count - The number of items.
+     * @return {uint32_t} The table capacity.
+     */
+    static uint32_t get_table_size(const std::size_t count)
+    {
+        uint32_t size = 16;
+        while (size < count * 2)
+            size <<= 1;
+        return size;
+    }
+
+    /**
+     * Sets the memory priority of the pages read by the calling thread.
+     *
+     * Pages read with a low priority are the first to be reused by the system, so a single pass over a large
+     * file does not evict the working sets of other processes.
+     *
+     * @param {bool} low - True to lower the priority, false to restore the default.
+     */
+    static void set_memory_priority(const bool low)
+    {
+        MEMORY_PRIORITY_INFORMATION info{};
+        info.MemoryPriority = low ? MEMORY_PRIORITY_LOW : MEMORY_PRIORITY_NORMAL;
+        ::SetThreadInformation(::GetCurrentThread(), ThreadMemoryPriority, &info, sizeof(info));
+    }
+
     /**
      * Opens the given url.
      *
@@ -107,8 +107,8 @@ LRESULT WINAPI dravex::window::on_message(HWND hwnd, UINT msg, WPARAM wparam, LP
             this->present_params_.FullScreen_RefreshRateInHz = 0;
             this->present_params_.PresentationInterval       = D3DPRESENT_INTERVAL_ONE;
 
-            // Create the Direct3D device..
-            if (FAILED(this->d3d9_->CreateDevice(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, hwnd, D3DCREATE_HARDWARE_VERTEXPROCESSING, &this->present_params_, &this->d3d9dev_)))
+            // Create the Direct3D device.. (Multithreaded, as the asset loader decodes textures into scratch surfaces on its worker.)
+            if (FAILED(this->d3d9_->CreateDevice(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, hwnd, D3DCREATE_HARDWARE_VERTEXPROCESSING | D3DCREATE_MULTITHREADED, &this->present_params_, &this->d3d9dev_)))
             {
                 std::cout << "[!] Error: Failed to create Direct3D9 device." << std::endl;
                 return -1;
@@ -272,7 +272,7 @@ void dravex::window::run()
  */
 bool dravex::window::reset_device(void)
 {
-    dravex::logging::instance().log(dravex::loglevel::debug, "[graphics] graphics device was reset; reinitializing objects..");
+    DRAVEX_LOG(dravex::loglevel::debug, "[graphics] graphics device was reset; reinitializing objects..");
 
     // Call reset callback (pre)..
     if (this->on_reset_)
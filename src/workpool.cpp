@@ -0,0 +1,144 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "workpool.hpp"
+#include "trace.hpp"
+
+/**
+ * Constructor and Destructor
+ *
+ * @param {std::string&} name - The name given to the worker threads. (Used in traces.)
+ * @param {uint32_t} threads - The number of worker threads to start.
+ * @param {int32_t} priority - The priority of the worker threads. (THREAD_PRIORITY_*)
+ */
+dravex::workpool::workpool(const std::string& name, const uint32_t threads, const int32_t priority)
+    : name_{name}
+    , priority_{priority}
+    , active_{0}
+    , stop_{false}
+{
+    for (uint32_t x = 0; x < std::max(1u, threads); x++)
+        this->workers_.emplace_back(&workpool::worker, this);
+}
+dravex::workpool::~workpool(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->jobs_.clear();
+        this->stop_ = true;
+    }
+    this->job_cv_.notify_all();
+
+    for (auto& t : this->workers_)
+    {
+        if (t.joinable())
+            t.join();
+    }
+}
+
+/**
+ * Worker thread callback that runs the queued jobs until the pool is destroyed.
+ */
+void dravex::workpool::worker(void)
+{
+    ::SetThreadPriority(::GetCurrentThread(), this->priority_);
+    dravex::tracing::instance().set_thread_name(this->name_.c_str());
+
+    while (true)
+    {
+        std::function<void(void)> job;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->job_cv_.wait(lock, [this]() { return this->stop_ || !this->jobs_.empty(); });
+
+            if (this->stop_)
+                return;
+
+            job = std::move(this->jobs_.front());
+            this->jobs_.pop_front();
+            this->active_++;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->active_--;
+        }
+        this->idle_cv_.notify_all();
+    }
+}
+
+/**
+ * Queues a job to be ran by the next available worker.
+ *
+ * @param {std::function} job - The job to run.
+ */
+void dravex::workpool::submit(std::function<void(void)> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->jobs_.push_back(std::move(job));
+    }
+    this->job_cv_.notify_one();
+}
+
+/**
+ * Removes all queued jobs that have not started yet.
+ *
+ * @return {std::size_t} The number of jobs removed.
+ */
+std::size_t dravex::workpool::clear(void)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    const auto count = this->jobs_.size();
+    this->jobs_.clear();
+    this->idle_cv_.notify_all();
+
+    return count;
+}
+
+/**
+ * Blocks until all queued and running jobs have finished.
+ */
+void dravex::workpool::wait(void)
+{
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->idle_cv_.wait(lock, [this]() { return this->jobs_.empty() && this->active_ == 0; });
+}
+
+/**
+ * Returns the number of queued and running jobs.
+ *
+ * @return {std::size_t} The pending job count.
+ */
+std::size_t dravex::workpool::get_pending(void)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->jobs_.size() + this->active_;
+}
@@ -0,0 +1,73 @@
+/**
+ * dravex - Copyright (c) 2022 atom0s [atom0s@live.com]
+ *
+ * Contact: https://www.atom0s.com/
+ * Contact: https://discord.gg/UmXNvjq
+ * Contact: https://github.com/atom0s
+ * Support: https://paypal.me/atom0s
+ * Support: https://patreon.com/atom0s
+ * Support: https://github.com/sponsors/atom0s
+ *
+ * This file is part of dravex.
+ *
+ * dravex is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * dravex is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with dravex.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKPOOL_HPP
+#define WORKPOOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include "defines.hpp"
+
+namespace dravex
+{
+    /**
+     * Fixed size pool of worker threads running queued jobs in submission order.
+     */
+    class workpool final
+    {
+        workpool(workpool const&)            = delete;
+        workpool(workpool&&)                 = delete;
+        workpool& operator=(workpool const&) = delete;
+        workpool& operator=(workpool&&)      = delete;
+
+        std::string name_;
+        int32_t priority_;
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void(void)>> jobs_;
+        std::mutex mutex_;
+        std::condition_variable job_cv_;
+        std::condition_variable idle_cv_;
+        uint32_t active_;
+        bool stop_;
+
+        void worker(void);
+
+    public:
+        workpool(const std::string& name, const uint32_t threads, const int32_t priority = THREAD_PRIORITY_NORMAL);
+        ~workpool(void);
+
+        auto submit(std::function<void(void)> job) -> void;
+        auto clear(void) -> std::size_t;
+        auto wait(void) -> void;
+
+        auto get_pending(void) -> std::size_t;
+    };
+
+} // namespace dravex
+
+#endif // WORKPOOL_HPP